@@ -77,6 +77,7 @@
 #pragma once
 
 #include <iostream>
+#include <atomic>
 #include <mutex>
 #include <stdlib.h>
 #include <time.h>
@@ -84,6 +85,390 @@
 #include <memory>
 #include <type_traits>
 #include <map>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#include <array>
+#include <initializer_list>
+#include <bit>
+#include <stdexcept>
+#include <fstream>
+#include <algorithm>
+#include <istream>
+#include <climits>
+#include <cerrno>
+#include <ostream>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <cmath>
+#include <source_location>
+#include <typeinfo>
+#include <iomanip>
+#if __has_include(<format>)
+    #include <format>
+#endif
+
+#if defined(_WIN32)
+    #if !defined(NOMINMAX)
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <io.h>
+    #include <malloc.h>
+    #include <intrin.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <signal.h>
+    #if defined(__GLIBC__)
+        #include <malloc.h>
+    #endif
+#endif
+
+
+/*
+** ScompileTimeKey
+* Generate keys at compile time, unique for each build and each call site
+*/
+
+// Optional key provided by the build system (e.g. /DMESCAMIT_BUILD_KEY=0x...), mixed with the build date and time
+#if !defined(MESCAMIT_BUILD_KEY)
+    #define MESCAMIT_BUILD_KEY 0
+#endif
+
+struct ScompileTimeKey {
+    // Hash a string of characters (FNV-1a)
+    static constexpr uint64_t hash(const char *_str) {
+        uint64_t ui64Hash(14695981039346656037ull);
+        for (int i(0); _str[i] != '\0'; ++i) {
+            ui64Hash ^= static_cast<uint8_t>(_str[i]);
+            ui64Hash *= 1099511628211ull;
+        }
+        return ui64Hash;
+    }
+
+    // Scramble a 64 bits integer (splitmix64 finalizer)
+    static constexpr uint64_t mix(uint64_t _ui64) {
+        _ui64 += 0x9E3779B97F4A7C15ull;
+        _ui64 = (_ui64 ^ (_ui64 >> 30)) * 0xBF58476D1CE4E5B9ull;
+        _ui64 = (_ui64 ^ (_ui64 >> 27)) * 0x94D049BB133111EBull;
+        return _ui64 ^ (_ui64 >> 31);
+    }
+
+    // Key word of the given index, derived from the seed
+    static constexpr uint64_t keyWord(const uint64_t _ui64Seed, const size_t _szIndex) {
+        return mix(_ui64Seed + _szIndex);
+    }
+
+    // Key byte of the given position, in the same order as a little endian read of the key words
+    static constexpr uint8_t keyByte(const uint64_t _ui64Seed, const size_t _szPos) {
+        return static_cast<uint8_t>(keyWord(_ui64Seed, _szPos / 8) >> ((_szPos % 8) * 8));
+    }
+
+    // XOR an array of bytes with the key derived from the seed, 8 bytes at once, then the remaining bytes
+    template <uint64_t Seed>
+    static void xorKey(const uint8_t *_ptrSrc, uint8_t *_ptrDst, const size_t _szSize) {
+        size_t i(0);
+        for (; i + 8 <= _szSize; i += 8) {
+            uint64_t ui64Word;
+            ::memcpy(&ui64Word, _ptrSrc + i, 8);
+            ui64Word ^= keyWord(Seed, i / 8);
+            ::memcpy(_ptrDst + i, &ui64Word, 8);
+        }
+        for (; i < _szSize; ++i)
+            _ptrDst[i] = _ptrSrc[i] ^ keyByte(Seed, i);
+    }
+};
+
+// Seed unique for each build and each expansion
+#define MESCAMIT_SEED (ScompileTimeKey::mix(ScompileTimeKey::hash(__DATE__ " " __TIME__ " " __FILE__) \
+                                             ^ static_cast<uint64_t>(MESCAMIT_BUILD_KEY) \
+                                             ^ (static_cast<uint64_t>(__COUNTER__) << 32) \
+                                             ^ static_cast<uint64_t>(__LINE__)))
+
+
+/*
+** SrandomMask
+* Generate 64 bits masks without the global ::rand() lock (xorshift64*, one generator per thread seeded with ::rand())
+*/
+
+struct SrandomMask {
+    static uint64_t gen() {
+        thread_local uint64_t tl_ui64State(0);
+        if (tl_ui64State == 0)
+            tl_ui64State = ScompileTimeKey::mix((static_cast<uint64_t>(::rand()) << 32) ^ reinterpret_cast<uintptr_t>(&tl_ui64State)) | 1;
+        tl_ui64State ^= tl_ui64State >> 12;
+        tl_ui64State ^= tl_ui64State << 25;
+        tl_ui64State ^= tl_ui64State >> 27;
+        return tl_ui64State * 0x2545F4914F6CDD1Dull;
+    }
+};
+
+
+/*
+** Scompressor
+* Byte oriented LZ77 codec (LZ4 block layout), used to shrink large text values before obfuscating them
+*
+*     +-------+----------+---------+--------+-------------+
+*     | TOKEN | LITERALS | LITERAL | OFFSET | MATCH       | ...   TOKEN: 4 bits literal length, 4 bits match length - 4
+*     |       | LENGTH+  | BYTES   | (2)    | LENGTH+     |       15 in a length means more bytes follow (255 each)
+*     +-------+----------+---------+--------+-------------+       The last sequence only holds literals
+*/
+
+struct Scompressor {
+    // Compress an array of bytes, returns the compressed size, or 0 if it does not fit in the given capacity
+    static int compress(const uint8_t *_ptrSrc, const int _iSize, uint8_t *_ptrDst, const int _iCapacity) {
+        // Last position of each hashed 4 bytes sequence
+        int32_t i32Table[s_iHashSize];
+        std::fill(i32Table, i32Table + s_iHashSize, -1);
+
+        int iSrc(0),
+            iAnchor(0),
+            iDst(0);
+        while (iSrc + s_iMinMatch <= _iSize) {
+            uint32_t ui32Seq;
+            ::memcpy(&ui32Seq, _ptrSrc + iSrc, s_iMinMatch);
+            uint32_t ui32Hash((ui32Seq * 2654435761u) >> (32 - s_iHashBits));
+            int iRef(i32Table[ui32Hash]);
+            i32Table[ui32Hash] = iSrc;
+
+            // No match within reach, try the next position
+            if (iRef < 0 || iSrc - iRef > 65535 || ::memcmp(_ptrSrc + iRef, _ptrSrc + iSrc, s_iMinMatch) != 0) {
+                ++iSrc;
+                continue;
+            }
+
+            // Extend the match as far as possible
+            int iLen(s_iMinMatch);
+            while (iSrc + iLen < _iSize && _ptrSrc[iRef + iLen] == _ptrSrc[iSrc + iLen])
+                ++iLen;
+
+            if (!_emit(_ptrSrc + iAnchor, iSrc - iAnchor, iSrc - iRef, iLen, _ptrDst, _iCapacity, &iDst))
+                return 0;
+
+            iSrc += iLen;
+            iAnchor = iSrc;
+        }
+
+        // Remaining literals
+        if (!_emit(_ptrSrc + iAnchor, _iSize - iAnchor, 0, 0, _ptrDst, _iCapacity, &iDst))
+            return 0;
+        return iDst;
+    }
+
+    // Decompress an array of bytes into a buffer of the exact expanded size, false if the data is corrupted
+    static bool decompress(const uint8_t *_ptrSrc, const int _iSize, uint8_t *_ptrDst, const int _iDstSize) {
+        int iSrc(0),
+            iDst(0);
+        while (iSrc < _iSize) {
+            uint8_t ui8Token(_ptrSrc[iSrc++]);
+
+            // Literals
+            int iLit(ui8Token >> 4);
+            if (iLit == 15 && !_readLength(_ptrSrc, _iSize, &iSrc, &iLit))
+                return false;
+            if (iLit > _iSize - iSrc || iLit > _iDstSize - iDst)
+                return false;
+            ::memcpy(_ptrDst + iDst, _ptrSrc + iSrc, iLit);
+            iSrc += iLit;
+            iDst += iLit;
+
+            // The last sequence only holds literals
+            if (iSrc == _iSize)
+                break;
+
+            // Match
+            if (_iSize - iSrc < 2)
+                return false;
+            int iOffset(_ptrSrc[iSrc] | (_ptrSrc[iSrc + 1] << 8)),
+                iLen(ui8Token & 15);
+            iSrc += 2;
+            if (iLen == 15 && !_readLength(_ptrSrc, _iSize, &iSrc, &iLen))
+                return false;
+            iLen += s_iMinMatch;
+            if (iOffset == 0 || iOffset > iDst || iLen > _iDstSize - iDst)
+                return false;
+
+            // Byte by byte, the match may overlap the bytes it produces
+            for (int i(0); i < iLen; ++i, ++iDst)
+                _ptrDst[iDst] = _ptrDst[iDst - iOffset];
+        }
+        return (iDst == _iDstSize);
+    }
+
+private:
+    // Write a sequence of literals followed by a match (no match if the length is 0)
+    static bool _emit(const uint8_t *_ptrLit, const int _iLit, const int _iOffset, const int _iLen, uint8_t *_ptrDst, const int _iCapacity, int *_iDst) {
+        // Token, lengths, literals and offset, at worst
+        if (static_cast<int64_t>(*_iDst) + 1 + (_iLit / 255 + 1) + _iLit + 2 + (_iLen / 255 + 1) > _iCapacity)
+            return false;
+
+        int iLenCode(_iLen > 0 ? _iLen - s_iMinMatch : 0);
+        _ptrDst[(*_iDst)++] = static_cast<uint8_t>((std::min(_iLit, 15) << 4) | std::min(iLenCode, 15));
+        if (_iLit >= 15)
+            _writeLength(_iLit - 15, _ptrDst, _iDst);
+        ::memcpy(_ptrDst + *_iDst, _ptrLit, _iLit);
+        *_iDst += _iLit;
+
+        if (_iLen > 0) {
+            _ptrDst[(*_iDst)++] = static_cast<uint8_t>(_iOffset);
+            _ptrDst[(*_iDst)++] = static_cast<uint8_t>(_iOffset >> 8);
+            if (iLenCode >= 15)
+                _writeLength(iLenCode - 15, _ptrDst, _iDst);
+        }
+        return true;
+    }
+
+    // Write the extra bytes of a length
+    static void _writeLength(int _iLen, uint8_t *_ptrDst, int *_iDst) {
+        for (; _iLen >= 255; _iLen -= 255)
+            _ptrDst[(*_iDst)++] = 255;
+        _ptrDst[(*_iDst)++] = static_cast<uint8_t>(_iLen);
+    }
+
+    // Read the extra bytes of a length
+    static bool _readLength(const uint8_t *_ptrSrc, const int _iSize, int *_iSrc, int *_iLen) {
+        uint8_t ui8Byte;
+        do {
+            if (*_iSrc >= _iSize || *_iLen > INT_MAX - 255)
+                return false;
+            ui8Byte = _ptrSrc[(*_iSrc)++];
+            *_iLen += ui8Byte;
+        } while (ui8Byte == 255);
+        return true;
+    }
+
+    static constexpr int s_iMinMatch = 4;
+    static constexpr int s_iHashBits = 12;
+    static constexpr int s_iHashSize = 1 << s_iHashBits;
+};
+
+
+/*
+** Sintegrity
+* Keyed checksum of the stored obfuscated values, and the function called when a value has been tampered with
+*/
+
+struct Sintegrity {
+    // Keyed 64 bits hash of an array of bytes, four independent lanes of 8 bytes,
+    // then 8 bytes at once, then the remaining bytes as a single zero padded word
+    static uint64_t hash(const uint8_t *_ptrSrc, const int _iSize, const uint64_t _ui64Key) {
+        uint64_t ui64Lane[4] { _ui64Key, _ui64Key ^ s_ui64Prime1, _ui64Key ^ s_ui64Prime2, _ui64Key ^ s_ui64Prime3 },
+                 ui64Word;
+        int i(0);
+        for (; i + 32 <= _iSize; i += 32)
+            for (int j(0); j < 4; ++j) {
+                ::memcpy(&ui64Word, _ptrSrc + i + j * 8, 8);
+                ui64Lane[j] = std::rotl((ui64Lane[j] ^ ui64Word) * s_ui64Prime1, 31);
+            }
+
+        uint64_t ui64Hash(static_cast<uint64_t>(_iSize) ^ std::rotl(ui64Lane[0], 1) ^ std::rotl(ui64Lane[1], 7) ^ std::rotl(ui64Lane[2], 12) ^ std::rotl(ui64Lane[3], 18));
+        for (; i + 8 <= _iSize; i += 8) {
+            ::memcpy(&ui64Word, _ptrSrc + i, 8);
+            ui64Hash = std::rotl((ui64Hash ^ ui64Word) * s_ui64Prime2, 27);
+        }
+        if (i < _iSize) {
+            ui64Word = 0;
+            ::memcpy(&ui64Word, _ptrSrc + i, _iSize - i);
+            ui64Hash = (ui64Hash ^ ui64Word) * s_ui64Prime3;
+        }
+        return ScompileTimeKey::mix(ui64Hash ^ _ui64Key);
+    }
+
+    // Called with the instance address before the error is thrown
+    static inline std::atomic<void (*)(const void *)> s_fnTamper = nullptr;
+
+private:
+    static constexpr uint64_t s_ui64Prime1 = 0x9E3779B185EBCA87ull;
+    static constexpr uint64_t s_ui64Prime2 = 0xC2B2AE3D27D4EB4Full;
+    static constexpr uint64_t s_ui64Prime3 = 0x165667B19E3779F9ull;
+};
+
+
+/*
+** SmemoryUsage, Smemory
+* Heap bytes held by the instances, split by purpose (see CvarObfuscated<T>::memory_usage()),
+* and the optional global budget which scales down the hops and padding of the next encodings
+*/
+
+struct SmemoryUsage {
+    size_t  m_szSpecs   = 0,    // Masked specifications and their address randomizer
+            m_szHops    = 0,    // Nodes of the linked lists of pointers
+            m_szKeys    = 0,    // Key sequences
+            m_szValues  = 0,    // Obfuscated values
+            m_szPadding = 0;    // Noise around the keys and values, and unused capacity
+
+    size_t total() const {
+        return m_szSpecs + m_szHops + m_szKeys + m_szValues + m_szPadding;
+    }
+
+    SmemoryUsage &operator+=(const SmemoryUsage &_usage) {
+        m_szSpecs   += _usage.m_szSpecs;
+        m_szHops    += _usage.m_szHops;
+        m_szKeys    += _usage.m_szKeys;
+        m_szValues  += _usage.m_szValues;
+        m_szPadding += _usage.m_szPadding;
+        return *this;
+    }
+};
+
+struct Smemory {
+    // Replace the usage of an allocation slot by a new one in the global accounting
+    static void replace(const SmemoryUsage &_usageOld, const SmemoryUsage &_usageNew) {
+        s_szSpecs.fetch_add(_usageNew.m_szSpecs - _usageOld.m_szSpecs, std::memory_order_relaxed);
+        s_szHops.fetch_add(_usageNew.m_szHops - _usageOld.m_szHops, std::memory_order_relaxed);
+        s_szKeys.fetch_add(_usageNew.m_szKeys - _usageOld.m_szKeys, std::memory_order_relaxed);
+        s_szValues.fetch_add(_usageNew.m_szValues - _usageOld.m_szValues, std::memory_order_relaxed);
+        s_szPadding.fetch_add(_usageNew.m_szPadding - _usageOld.m_szPadding, std::memory_order_relaxed);
+        s_szTotal.fetch_add(_usageNew.total() - _usageOld.total(), std::memory_order_relaxed);
+        s_ui64Activity.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Usage of every instance
+    static SmemoryUsage global() {
+        return SmemoryUsage {
+            s_szSpecs.load(std::memory_order_relaxed),
+            s_szHops.load(std::memory_order_relaxed),
+            s_szKeys.load(std::memory_order_relaxed),
+            s_szValues.load(std::memory_order_relaxed),
+            s_szPadding.load(std::memory_order_relaxed)
+        };
+    }
+
+    // Range allowed by the budget, shrinking linearly to zero between three quarters of the budget and the budget
+    static int range(const int _iRange) {
+        size_t szBudget(s_szBudget.load(std::memory_order_relaxed));
+        if (szBudget != 0) {
+            size_t szUsed(s_szTotal.load(std::memory_order_relaxed)),
+                   szSoft(szBudget - szBudget / 4);
+            if (szUsed >= szBudget)
+                return 0;
+            if (szUsed > szSoft)
+                return static_cast<int>(static_cast<double>(_iRange) * (szBudget - szUsed) / (szBudget - szSoft));
+        }
+        return _iRange;
+    }
+
+    // Random number below the range allowed by the budget
+    static int spread(const int _iRange) {
+        int iRange(range(_iRange));
+        return (iRange > 0) ? ::rand() % iRange : 0;
+    }
+
+    // Unsigned wrapping makes the subtractions of replace() exact
+    static inline std::atomic<size_t>   s_szSpecs   = 0,
+                                        s_szHops    = 0,
+                                        s_szKeys    = 0,
+                                        s_szValues  = 0,
+                                        s_szPadding = 0,
+                                        s_szTotal   = 0,
+                                        s_szBudget  = 0;    // No budget if 0
+    static inline std::atomic<uint64_t> s_ui64Activity  = 0;    // Number of replacements, to detect idle periods
+};
 
 
 /*
@@ -132,6 +517,185 @@ struct SspecsKey : public SspecsVal {
 };
 
 
+/*
+** SpersistRegistry
+* Instances saved and restored by CvarObfuscated<void>::snapshot() and CvarObfuscated<void>::restore(),
+* indexed by their persistence identifier (see CvarObfuscated<T>::persist())
+*/
+
+struct SpersistRegistry {
+    // Type erased access to a persisted instance
+    struct Sentry {
+        void  *m_ptrInst = nullptr;
+        // Export the stored value XORed with the given key instead of the instance key, false if empty
+        bool (*m_fnExport)(void *, std::vector<uint8_t> *, const uint8_t *, const int) = nullptr;
+        // Check if a payload size matches the stored type
+        bool (*m_fnIsValidSize)(const int) = nullptr;
+        // Import a value XORed with the given key, and store it XORed with a new instance key
+        void (*m_fnImport)(void *, const uint8_t *, const int, const uint8_t *, const int) = nullptr;
+    };
+
+    static inline std::mutex                    s_mtx;
+    static inline std::map<uint64_t, Sentry>    s_mapEntries;
+};
+
+
+/*
+** SscanRegistry
+* Instances checked by the integrity scanner (see CvarObfuscated<void>::scan_step()),
+* every instance with an integrity check or a redundant storage enabled, indexed by address
+* The registry mutex is always taken before an instance mutex, never after
+*/
+
+struct SscanRegistry {
+    // Type erased check of an instance under its own mutex, adds the number of bytes read,
+    // returns the reason of a violation or nullptr
+    using FnCheck = const char *(*)(void *, size_t *);
+
+    static inline std::mutex                s_mtx;
+    static inline std::map<void *, FnCheck> s_mapEntries;
+    static inline void                     *s_ptrCursor     = nullptr;  // Last instance checked
+    static inline std::atomic<void (*)(const void *, const char *)> s_fnViolation = nullptr;
+
+    // Background scanner (see CvarObfuscated<void>::scan_start())
+    static inline std::mutex                s_mtxThread;
+    static inline std::condition_variable   s_cvThread;
+    static inline std::thread               s_thread;
+    static inline bool                      s_bStop         = false;
+};
+
+
+/*
+** SrelocRegistry
+* Instances whose buffers may be moved to fresh allocations (see CvarObfuscated<T>::set_relocation()),
+* indexed by address
+* The registry mutex is always taken before an instance mutex, never after
+*/
+
+struct SrelocRegistry {
+    // Type erased relocation of an instance under its own mutex, the previous buffers being released
+    // before the new ones are allocated (compaction) or after (fresh addresses)
+    using FnRelocate = void (*)(void *, const bool);
+
+    static inline std::mutex                    s_mtx;
+    static inline std::map<void *, FnRelocate>  s_mapEntries;
+    static inline void                         *s_ptrCursor = nullptr;  // Last instance moved by relocate_step()
+
+    // Idle trimmer (see CvarObfuscated<void>::trim_start())
+    static inline std::mutex                    s_mtxThread;
+    static inline std::condition_variable       s_cvThread;
+    static inline std::thread                   s_thread;
+    static inline bool                          s_bStop     = false;
+
+    // Background relocation (see CvarObfuscated<void>::relocate_start())
+    static inline std::mutex                    s_mtxMover;
+    static inline std::condition_variable       s_cvMover;
+    static inline std::thread                   s_threadMover;
+    static inline bool                          s_bMoverStop = false;
+};
+
+
+/*
+** Sprofiler
+* Number of calls and cumulated time of the CvarObfuscated<T> operators per call site and type
+* (see CvarObfuscated<void>::profile_report()), in a fixed open addressing table filled without locks
+* The named methods identify their call site with a std::source_location,
+* the operators with their return address, as an operator can not take a defaulted argument
+* Only compiled with MESCAMIT_PROFILE defined, the table does not weigh on the other builds
+*/
+
+#if defined(MESCAMIT_PROFILE)
+struct Sprofiler {
+    struct Sslot {
+        std::atomic<uint64_t>   m_ui64Site      = 0;        // Hash of the call site, 0 if the slot is free
+        std::atomic<bool>       m_bReady        = false;    // Description written
+        const char             *m_szOperator    = nullptr,
+                               *m_szType        = nullptr,
+                               *m_szFile        = nullptr,
+                               *m_szFunction    = nullptr;
+        uint32_t                m_ui32Line      = 0;
+        const void             *m_ptrAddr       = nullptr;  // Return address of an operator
+        std::atomic<uint64_t>   m_ui64Calls     = 0,
+                                m_ui64Nanos     = 0;
+    };
+
+    // Count a call and its duration once the scope ends
+    struct Sscope {
+        explicit Sscope(Sslot *_ptrSlot) : m_ptrSlot(_ptrSlot), m_tpBeg(std::chrono::steady_clock::now()) {}
+
+        ~Sscope() {
+            if (m_ptrSlot == nullptr)
+                return;
+            uint64_t ui64Nanos(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_tpBeg).count()));
+            m_ptrSlot->m_ui64Calls.fetch_add(1, std::memory_order_relaxed);
+            m_ptrSlot->m_ui64Nanos.fetch_add(ui64Nanos, std::memory_order_relaxed);
+        }
+
+        Sslot                                  *m_ptrSlot;
+        std::chrono::steady_clock::time_point   m_tpBeg;
+    };
+
+    // Slot of a named method call site
+    static Sslot *site(const std::source_location &_loc, const char *_szOperator, const char *_szType) {
+        uint64_t ui64Site(ScompileTimeKey::mix(reinterpret_cast<uintptr_t>(_loc.file_name()) ^ (static_cast<uint64_t>(_loc.line()) << 32) ^ _loc.column()));
+        return _find(ScompileTimeKey::mix(ui64Site ^ reinterpret_cast<uintptr_t>(_szOperator) ^ ScompileTimeKey::mix(reinterpret_cast<uintptr_t>(_szType))),
+                     _szOperator, _szType, _loc.file_name(), _loc.function_name(), _loc.line(), nullptr);
+    }
+
+    // Slot of an operator call site
+    static Sslot *site(const void *_ptrAddr, const char *_szOperator, const char *_szType) {
+        return _find(ScompileTimeKey::mix(reinterpret_cast<uintptr_t>(_ptrAddr) ^ ScompileTimeKey::mix(reinterpret_cast<uintptr_t>(_szType))),
+                     _szOperator, _szType, nullptr, nullptr, 0, _ptrAddr);
+    }
+
+    // Find or claim the slot of a call site with linear probing, nullptr if the table is full
+    static Sslot *_find(uint64_t _ui64Site, const char *_szOperator, const char *_szType,
+                        const char *_szFile, const char *_szFunction, const uint32_t _ui32Line, const void *_ptrAddr) {
+        _ui64Site |= 1;
+        for (size_t i(0); i < s_szSlots; ++i) {
+            Sslot &slot(s_arrSlots[(_ui64Site + i) % s_szSlots]);
+            uint64_t ui64Site(slot.m_ui64Site.load(std::memory_order_acquire));
+            if (ui64Site == 0 && slot.m_ui64Site.compare_exchange_strong(ui64Site, _ui64Site, std::memory_order_acq_rel)) {
+                // Claimed, describe the call site before publishing it
+                slot.m_szOperator = _szOperator;
+                slot.m_szType     = _szType;
+                slot.m_szFile     = _szFile;
+                slot.m_szFunction = _szFunction;
+                slot.m_ui32Line   = _ui32Line;
+                slot.m_ptrAddr    = _ptrAddr;
+                slot.m_bReady.store(true, std::memory_order_release);
+                return &slot;
+            }
+            if (ui64Site == _ui64Site)
+                return &slot;
+        }
+        s_ui64Dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    static constexpr size_t             s_szSlots       = 4096;
+    static Sslot                        s_arrSlots[s_szSlots];  // Defined below, Sslot must be complete
+    static inline std::atomic<uint64_t> s_ui64Dropped   = 0;    // Calls not counted, the table being full
+};
+
+inline Sprofiler::Sslot Sprofiler::s_arrSlots[Sprofiler::s_szSlots];
+
+    #if defined(_MSC_VER)
+        #define MESCAMIT_PROFILE_NOINLINE   __declspec(noinline)
+        #define MESCAMIT_RETURN_ADDRESS     _ReturnAddress()
+    #else
+        #define MESCAMIT_PROFILE_NOINLINE   __attribute__((noinline))
+        #define MESCAMIT_RETURN_ADDRESS     __builtin_return_address(0)
+    #endif
+    #define MESCAMIT_PROFILE_CALLER(_szOperator)        const Sprofiler::Sscope profScope(Sprofiler::site(MESCAMIT_RETURN_ADDRESS, _szOperator, typeid(T).name()))
+    #define MESCAMIT_PROFILE_SITE(_loc, _szOperator)    const Sprofiler::Sscope profScope(Sprofiler::site(_loc, _szOperator, typeid(T).name()))
+#else
+    #define MESCAMIT_PROFILE_NOINLINE
+    #define MESCAMIT_PROFILE_CALLER(_szOperator)
+    #define MESCAMIT_PROFILE_SITE(_loc, _szOperator)    (void)_loc
+#endif
+
+
 /*
 ** CvarObfuscated
 * Obfuscate variables or structs from memory scanners
@@ -142,23 +706,161 @@ class CvarObfuscated {
 public:
     // Destructor
     ~CvarObfuscated() {
+        // Leave the persistence registry first, so no snapshot reaches a dying instance
+        if (m_ui64PersistId != 0)
+            persist("");
+        // Same for the integrity scanner and the relocation
+        if (m_bScanned) {
+            const std::lock_guard<std::mutex> lockRegistry(SscanRegistry::s_mtx);
+            SscanRegistry::s_mapEntries.erase(this);
+        }
+        if (m_bRelocatable)
+            set_relocation(false);
+
         const std::lock_guard<std::mutex> lock(m_mtx);
         _flush(true);
+        _shadowFlush();
+        delete m_ptrShadow;
+        _memReplace(&m_memShadow, SmemoryUsage {});
+        delete m_ptrScanRecord;
+        _memReplace(&m_memScan, SmemoryUsage {});
+    }
+
+    // Define the identifier used to save and restore the value (see CvarObfuscated<void>::snapshot()),
+    // an empty identifier stops the persistence of the value
+    void persist(const std::string &_strId) {
+        uint64_t ui64Id(_strId.empty() ? 0 : (ScompileTimeKey::hash(_strId.c_str()) | 1));
+
+        const std::lock_guard<std::mutex> lock(SpersistRegistry::s_mtx);
+
+        // Two values can not share an identifier
+        if (ui64Id != 0) {
+            auto itEntry(SpersistRegistry::s_mapEntries.find(ui64Id));
+            if (itEntry != SpersistRegistry::s_mapEntries.end() && itEntry->second.m_ptrInst != this)
+                throw std::runtime_error("This persistence identifier is already used.");
+        }
+
+        if (m_ui64PersistId != 0)
+            SpersistRegistry::s_mapEntries.erase(m_ui64PersistId);
+
+        m_ui64PersistId = ui64Id;
+        if (ui64Id != 0)
+            SpersistRegistry::s_mapEntries[ui64Id] = SpersistRegistry::Sentry {
+                this,
+                [](void *_ptrInst, std::vector<uint8_t> *_vecOut, const uint8_t *_ui8Key, const int _iKeySize) {
+                    return static_cast<CvarObfuscated *>(_ptrInst)->_exportVal(_vecOut, _ui8Key, _iKeySize);
+                },
+                &CvarObfuscated::_isValidSize,
+                [](void *_ptrInst, const uint8_t *_ui8Enc, const int _iSize, const uint8_t *_ui8Key, const int _iKeySize) {
+                    static_cast<CvarObfuscated *>(_ptrInst)->_importVal(_ui8Enc, _iSize, _ui8Key, _iKeySize);
+                }
+            };
     }
 
     // Getter
-    operator T() {
+    MESCAMIT_PROFILE_NOINLINE operator T() {
+        MESCAMIT_PROFILE_CALLER("operator T");
         const std::lock_guard<std::mutex> lock(m_mtx);
         return _get();
     }
 
+    // Heap bytes currently held by this instance, split by purpose (see CvarObfuscated<void>::memory_usage())
+    SmemoryUsage memory_usage() {
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        SmemoryUsage usage(m_memSpecs);
+        usage += m_memKey;
+        usage += m_memVal;
+        usage += m_memShadow;
+        usage += m_memScan;
+        return usage;
+    }
+
+    // Verify on every read that the stored value has not been modified since it was written,
+    // a modified value throws an error (see CvarObfuscated<void>::set_tamper_callback())
+    void set_integrity(const bool _bEnable) {
+        {
+            const std::lock_guard<std::mutex> lock(m_mtx);
+            m_bIntegrity = _bEnable;
+            if (m_bIntegrity) {
+                m_ui64ChecksumKey = SrandomMask::gen();
+                // Seal the current value
+                if (!m_bEmpty) {
+                    SspecsVal *ptrSpecsVal(reinterpret_cast<SspecsVal *>(_retrieveSpecs(Especs_::Especs_Val)));
+                    int iValSize(ptrSpecsVal->m_mvSize.get()),
+                        iValOffset(ptrSpecsVal->m_mvOffset.get());
+                    _sealVal(_ptrUnfold(&ptrSpecsVal->m_mvPtr, &ptrSpecsVal->m_mvHopNbr) + iValOffset, iValSize);
+                }
+            }
+        }
+        _scanUpdate();
+    }
+
+    // Store a second copy of the value under its own key, reached through its own hop chains,
+    // every read decodes both copies and throws an error if they differ (see CvarObfuscated<void>::set_tamper_callback())
+    void set_redundancy(const bool _bEnable) {
+        {
+            const std::lock_guard<std::mutex> lock(m_mtx);
+            if (_bEnable && m_ptrShadow == nullptr) {
+                m_ptrShadow = new Sshadow();
+                _memReplace(&m_memShadow, SmemoryUsage { sizeof(Sshadow) });
+                // Copy the current value
+                if (!m_bEmpty) {
+                    SspecsVal *ptrSpecsVal(reinterpret_cast<SspecsVal *>(_retrieveSpecs(Especs_::Especs_Val)));
+                    int iValSize(ptrSpecsVal->m_mvSize.get()),
+                        iValOffset(ptrSpecsVal->m_mvOffset.get());
+                    _sealVal(_ptrUnfold(&ptrSpecsVal->m_mvPtr, &ptrSpecsVal->m_mvHopNbr) + iValOffset, iValSize);
+                }
+            }
+            else if (!_bEnable && m_ptrShadow != nullptr) {
+                _shadowFlush();
+                delete m_ptrShadow;
+                m_ptrShadow = nullptr;
+                _memReplace(&m_memShadow, SmemoryUsage {});
+            }
+        }
+        _scanUpdate();
+    }
+
+    // Compress the next values before obfuscating them, if they are large and compressible enough
+    void set_compression(const bool _bEnable) requires std::is_same_v<T, std::string> {
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        m_bCompression = _bEnable;
+    }
+
+    // Allow the buffers, keys and hops to be moved to fresh allocations without being deobfuscated
+    // (see CvarObfuscated<void>::trim() and CvarObfuscated<void>::relocate_step())
+    void set_relocation(const bool _bEnable) {
+        const std::lock_guard<std::mutex> lockRegistry(SrelocRegistry::s_mtx);
+        m_bRelocatable = _bEnable;
+        if (m_bRelocatable)
+            SrelocRegistry::s_mapEntries[this] = &_relocateEntry;
+        else
+            SrelocRegistry::s_mapEntries.erase(this);
+    }
+
+    // Pick the number of hops of the next encodings from a decaying access counter, within the given limits,
+    // the most accessed instances get the shallowest chains and the rarely accessed ones the deepest,
+    // the depth follows the heat at the next write or relocation
+    void set_adaptive_hops(const bool _bEnable, const uint8_t _ui8HopMin = 1, const uint8_t _ui8HopMax = 7) {
+        if (_ui8HopMin < 1 || _ui8HopMax > 7 || _ui8HopMin > _ui8HopMax)
+            throw std::runtime_error("The hop limits must be ordered, and within 1 and 7.");
+
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        m_bAdaptiveHops = _bEnable;
+        m_ui8HopMin     = _ui8HopMin;
+        m_ui8HopMax     = _ui8HopMax;
+        m_dHeat         = 0;
+        m_tpHeat        = std::chrono::steady_clock::now();
+    }
+
 
     /*
     ** Assignment Operators
     */
 
     // = Assignation
-    T operator=(const T &_val) {
+    MESCAMIT_PROFILE_NOINLINE T operator=(const T &_val) {
+        MESCAMIT_PROFILE_CALLER("operator =");
         const std::lock_guard<std::mutex> lock(m_mtx);
         _set(_val);
         return _val;
@@ -170,31 +872,36 @@ public:
     */
 
     // + Addition
-    T operator + (const T &_val) {
+    MESCAMIT_PROFILE_NOINLINE T operator + (const T &_val) {
+        MESCAMIT_PROFILE_CALLER("operator +");
         const std::lock_guard<std::mutex> lock(m_mtx);
         return (_get() + _val);
     }
 
     // - Subtraction
-    T operator - (const T &_val) {
+    MESCAMIT_PROFILE_NOINLINE T operator - (const T &_val) {
+        MESCAMIT_PROFILE_CALLER("operator -");
         const std::lock_guard<std::mutex> lock(m_mtx);
         return (_get() - _val);
     }
 
     // * Multiplication
-    T operator * (const T &_val) {
+    MESCAMIT_PROFILE_NOINLINE T operator * (const T &_val) {
+        MESCAMIT_PROFILE_CALLER("operator *");
         const std::lock_guard<std::mutex> lock(m_mtx);
         return (_get() * _val);
     }
 
     // / Division
-    T operator / (const T &_val) {
+    MESCAMIT_PROFILE_NOINLINE T operator / (const T &_val) {
+        MESCAMIT_PROFILE_CALLER("operator /");
         const std::lock_guard<std::mutex> lock(m_mtx);
         return (_get() / _val);
     }
 
     // % Modulo operation (Remainder after division)
-    T operator % (const T &_val) {
+    MESCAMIT_PROFILE_NOINLINE T operator % (const T &_val) {
+        MESCAMIT_PROFILE_CALLER("operator %");
         const std::lock_guard<std::mutex> lock(m_mtx);
         return (_get() % _val);
     }
@@ -205,43 +912,47 @@ public:
     */
 
     // += Addition
-    T operator += (const T &_val) {
+    MESCAMIT_PROFILE_NOINLINE T operator += (const T &_val) {
+        MESCAMIT_PROFILE_CALLER("operator +=");
         const std::lock_guard<std::mutex> lock(m_mtx);
         if constexpr (std::is_same_v<T, std::string>) {
             std::string val(_get());
             val.append(_val);
-            _set(val);
+            _set(val, false);
             return val;
         }
         else {
             T val(_get());
             val += _val;
-            _set(val);
+            _set(val, false);
             return val;
         }
     }
 
     // -= Subtraction
-    T operator -= (const T &_val) {
+    MESCAMIT_PROFILE_NOINLINE T operator -= (const T &_val) {
+        MESCAMIT_PROFILE_CALLER("operator -=");
         const std::lock_guard<std::mutex> lock(m_mtx);
         T val(_get() - _val);
-        _set(val);
+        _set(val, false);
         return val;
     }
 
     // *= Division
-    T operator *= (const T &_val) {
+    MESCAMIT_PROFILE_NOINLINE T operator *= (const T &_val) {
+        MESCAMIT_PROFILE_CALLER("operator *=");
         const std::lock_guard<std::mutex> lock(m_mtx);
         T val(_get() * _val);
-        _set(val);
+        _set(val, false);
         return val;
     }
 
     // /= Division
-    T operator /= (const T &_val) {
+    MESCAMIT_PROFILE_NOINLINE T operator /= (const T &_val) {
+        MESCAMIT_PROFILE_CALLER("operator /=");
         const std::lock_guard<std::mutex> lock(m_mtx);
         T val(_get() / _val);
-        _set(val);
+        _set(val, false);
         return val;
     }
 
@@ -251,32 +962,37 @@ public:
     */
 
     // & Bitwise AND
-    T operator & (T _iMask) {
+    MESCAMIT_PROFILE_NOINLINE T operator & (T _iMask) {
+        MESCAMIT_PROFILE_CALLER("operator &");
         const std::lock_guard<std::mutex> lock(m_mtx);
         return (_get() & _iMask);
     }
 
     // | Bitwise OR
-    T operator | (T _iMask) {
+    MESCAMIT_PROFILE_NOINLINE T operator | (T _iMask) {
+        MESCAMIT_PROFILE_CALLER("operator |");
         const std::lock_guard<std::mutex> lock(m_mtx);
         return (_get() | _iMask);
     }
 
     // ^ Bitwise XOR
-    T operator ^ (T _iMask) {
+    MESCAMIT_PROFILE_NOINLINE T operator ^ (T _iMask) {
+        MESCAMIT_PROFILE_CALLER("operator ^");
         const std::lock_guard<std::mutex> lock(m_mtx);
         T val(_get() ^ _iMask);
         return val;
     }
     
     // << Bitwise shift left
-    T operator << (int _i) {
+    MESCAMIT_PROFILE_NOINLINE T operator << (int _i) {
+        MESCAMIT_PROFILE_CALLER("operator <<");
         const std::lock_guard<std::mutex> lock(m_mtx);
         return (_get() << _i);
     }
 
     // >> Bitwise shift right
-    T operator >> (int _i) {
+    MESCAMIT_PROFILE_NOINLINE T operator >> (int _i) {
+        MESCAMIT_PROFILE_CALLER("operator >>");
         const std::lock_guard<std::mutex> lock(m_mtx);
         return (_get() >> _i);
     }
@@ -287,26 +1003,29 @@ public:
     */
 
     // &= Bitwise Compound Assignment AND
-    T operator &= (T _iMask) {
+    MESCAMIT_PROFILE_NOINLINE T operator &= (T _iMask) {
+        MESCAMIT_PROFILE_CALLER("operator &=");
         const std::lock_guard<std::mutex> lock(m_mtx);
         T val(_get() & _iMask);
-        _set(val);
+        _set(val, false);
         return val;
     }
 
     // ^= Bitwise Compound Assignment XOR
-    T operator ^= (T _iMask) {
+    MESCAMIT_PROFILE_NOINLINE T operator ^= (T _iMask) {
+        MESCAMIT_PROFILE_CALLER("operator ^=");
         const std::lock_guard<std::mutex> lock(m_mtx);
         T val(_get() ^ _iMask);
-        _set(val);
+        _set(val, false);
         return val;
     }
 
     // |= Bitwise Compound Assignment OR
-    T operator |= (T _iMask) {
+    MESCAMIT_PROFILE_NOINLINE T operator |= (T _iMask) {
+        MESCAMIT_PROFILE_CALLER("operator |=");
         const std::lock_guard<std::mutex> lock(m_mtx);
         T val(_get() | _iMask);
-        _set(val);
+        _set(val, false);
         return val;
     }
 
@@ -316,38 +1035,207 @@ public:
     */
 
     // ++ Increment prefix
-    T operator ++ () {
+    MESCAMIT_PROFILE_NOINLINE T operator ++ () {
+        MESCAMIT_PROFILE_CALLER("operator ++");
         const std::lock_guard<std::mutex> lock(m_mtx);
         T val(_get() + 1);
-        _set(val);
+        _set(val, false);
         return val;
     }
 
     // ++ Increment postfix
-    T operator ++ (int) {
+    MESCAMIT_PROFILE_NOINLINE T operator ++ (int) {
+        MESCAMIT_PROFILE_CALLER("operator ++ (postfix)");
         const std::lock_guard<std::mutex> lock(m_mtx);
-        T val(_get() + 1);
-        _set(val);
+        T val(_get());
+        _set(val + 1, false);
         return val;
     }
 
     // -- Decrement prefix
-    T operator -- () {
+    MESCAMIT_PROFILE_NOINLINE T operator -- () {
+        MESCAMIT_PROFILE_CALLER("operator --");
         const std::lock_guard<std::mutex> lock(m_mtx);
         T val(_get() - 1 );
-        _set(val);
+        _set(val, false);
         return val;
     }
 
     // -- Decrement postfix
-    T operator -- (int) {
+    MESCAMIT_PROFILE_NOINLINE T operator -- (int) {
+        MESCAMIT_PROFILE_CALLER("operator -- (postfix)");
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        T val(_get());
+        _set(val - 1, false);
+        return val;
+    }
+
+
+    /*
+    ** Atomic Operations
+    * Every read-modify-write is done under a single hold of the instance mutex,
+    * the same semantics as std::atomic can be expected without an outside lock
+    */
+
+    // Retrieve the value
+    T load(const std::source_location _loc = std::source_location::current()) {
+        MESCAMIT_PROFILE_SITE(_loc, "load");
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        return _get();
+    }
+
+    // Replace the value
+    void store(const T &_val, const std::source_location _loc = std::source_location::current()) {
+        MESCAMIT_PROFILE_SITE(_loc, "store");
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        _set(_val);
+    }
+
+    // Replace the value, and return the previous one
+    T exchange(const T &_val, const std::source_location _loc = std::source_location::current()) {
+        MESCAMIT_PROFILE_SITE(_loc, "exchange");
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        T val(_get());
+        _set(_val, false);
+        return val;
+    }
+
+    // Replace the value with the desired one if it is equal to the expected one,
+    // otherwise the expected one is updated with the actual value
+    bool compare_exchange_strong(T &_expected, const T &_desired, const std::source_location _loc = std::source_location::current()) {
+        MESCAMIT_PROFILE_SITE(_loc, "compare_exchange_strong");
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        T val(_get());
+        if (_isEqual(val, _expected)) {
+            _set(_desired, false);
+            return true;
+        }
+        _expected = val;
+        return false;
+    }
+
+    // Add to the value, and return the previous one
+    T fetch_add(const T &_val, const std::source_location _loc = std::source_location::current()) {
+        MESCAMIT_PROFILE_SITE(_loc, "fetch_add");
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        T val(_get());
+        _set(val + _val, false);
+        return val;
+    }
+
+    // Subtract from the value, and return the previous one
+    T fetch_sub(const T &_val, const std::source_location _loc = std::source_location::current()) {
+        MESCAMIT_PROFILE_SITE(_loc, "fetch_sub");
         const std::lock_guard<std::mutex> lock(m_mtx);
-        T val(_get() - 1);
-        _set(val);
+        T val(_get());
+        _set(val - _val, false);
         return val;
     }
 
 
+    /*
+    ** Streaming Import
+    * The value is read by chunks directly into its memory buffer, each chunk is obfuscated as soon as it is read,
+    * no plain text exists beyond a single chunk
+    */
+
+    // Load the value from a file descriptor until its end, returns the number of bytes read
+    size_t assign_from_fd(const int _iFd) requires std::is_same_v<T, std::string> {
+        return _assignFrom([&](uint8_t *_ptrDst, const int _iLen) -> int {
+#if defined(_WIN32)
+            return ::_read(_iFd, _ptrDst, static_cast<unsigned int>(_iLen));
+#else
+            int iRead;
+            // Retry if interrupted by a signal
+            do {
+                iRead = static_cast<int>(::read(_iFd, _ptrDst, static_cast<size_t>(_iLen)));
+            } while (iRead < 0 && errno == EINTR);
+            return iRead;
+#endif
+        });
+    }
+
+    // Load the value from an input stream until its end, returns the number of bytes read
+    size_t assign_from(std::istream &_is) requires std::is_same_v<T, std::string> {
+        return _assignFrom([&](uint8_t *_ptrDst, const int _iLen) -> int {
+            _is.read(reinterpret_cast<char *>(_ptrDst), _iLen);
+            if (_is.bad())
+                return -1;
+            return static_cast<int>(_is.gcount());
+        });
+    }
+
+
+    /*
+    ** Streaming Export
+    * The value is deobfuscated by chunks into a reused stack buffer, each chunk is wiped once written,
+    * no plain text exists beyond a single chunk
+    * The instance stays locked until the whole value is written
+    */
+
+    // Write the value to a file descriptor, returns the number of bytes written
+    size_t write_to(const int _iFd) {
+        return _writeTo([&](const uint8_t *_ptrSrc, const int _iLen) -> bool {
+            int iDone(0);
+            // Retry until the whole chunk is written, or if interrupted by a signal
+            while (iDone < _iLen) {
+#if defined(_WIN32)
+                int iWritten(::_write(_iFd, _ptrSrc + iDone, static_cast<unsigned int>(_iLen - iDone)));
+#else
+                int iWritten(static_cast<int>(::write(_iFd, _ptrSrc + iDone, static_cast<size_t>(_iLen - iDone))));
+                if (iWritten < 0 && errno == EINTR)
+                    continue;
+#endif
+                if (iWritten <= 0)
+                    return false;
+                iDone += iWritten;
+            }
+            return true;
+        });
+    }
+
+    // Write the value to an output stream, returns the number of bytes written
+    size_t write_to(std::ostream &_os) {
+        return _writeTo([&](const uint8_t *_ptrSrc, const int _iLen) -> bool {
+            _os.write(reinterpret_cast<const char *>(_ptrSrc), _iLen);
+            return !_os.bad();
+        });
+    }
+
+
+    /*
+    ** Wait and Notify
+    * Every write increments a version counter, waiting threads sleep on it
+    * instead of repeatedly deobfuscating the value
+    */
+
+    // Block until the value differs from the given one,
+    // a write must be followed by notify_one() or notify_all() to wake the waiting threads
+    void wait(const T &_old) {
+        while (true) {
+            uint32_t ui32Version;
+            {
+                const std::lock_guard<std::mutex> lock(m_mtx);
+                if (!_isEqual(_get(), _old))
+                    return;
+                ui32Version = m_ui32Version.load(std::memory_order_acquire);
+            }
+            // Sleep until the version counter is changed by a write
+            m_ui32Version.wait(ui32Version, std::memory_order_acquire);
+        }
+    }
+
+    // Wake up one of the threads waiting for a change
+    void notify_one() {
+        m_ui32Version.notify_one();
+    }
+
+    // Wake up all the threads waiting for a change
+    void notify_all() {
+        m_ui32Version.notify_all();
+    }
+
+
     /*
     ** Relational Operators
     */
@@ -362,71 +1250,49 @@ public:
     struct is_map<std::map<R, S, Alloc>> : public std::true_type {};
 
     // == Is equal to
-    bool operator == (const T &_vr) {
+    MESCAMIT_PROFILE_NOINLINE bool operator == (const T &_vr) {
+        MESCAMIT_PROFILE_CALLER("operator ==");
         const std::lock_guard<std::mutex> lock(m_mtx);
-        // If the right value is a std::vector
-        if constexpr (is_vector<T>::value) {
-            return (_get() == _vr);
-        }
-        // If the right value is a std::map
-        else if constexpr (is_map<T>::value) {
-            return(_get() == _vr);
-        }
-        // If the right value can be compared byte to byte
-        else {
-            int iSize(sizeof(T));
-            T vl(_get());
-            return (::memcmp(&vl, &_vr, iSize) == 0);
-        }
+        return _isEqual(_get(), _vr);
     }
 
     // != Not equal to
-    bool operator != (const T &_vr) {
+    MESCAMIT_PROFILE_NOINLINE bool operator != (const T &_vr) {
+        MESCAMIT_PROFILE_CALLER("operator !=");
         const std::lock_guard<std::mutex> lock(m_mtx);
-        // If the right value is a std::vector
-        if constexpr (is_vector<T>::value) {
-            return (_get() != _vr);
-        }
-        // If the right value is a std::map
-        else if constexpr (is_map<T>::value) {
-            return(_get() != _vr);
-        }
-        // If the right value can be compared byte to byte
-        else {
-            int iSize(sizeof(T));
-            T vl(_get());
-            return (::memcmp(&vl, &_vr, iSize) != 0);
-        }
+        return !_isEqual(_get(), _vr);
     }
 
 private:
+#if defined(__cpp_lib_format)
+    template <typename, typename> friend struct std::formatter;
+#endif
+
     /*
     ** Setter and Getter
     */
 
-    // Setter
-    void _set(const T &_val) {
-        // If not empty, erase all data and dynamic arrays
-        _flush();
-        
-        // Allocate the dynamic variables to store the value's and key's specifications
-        _alloc();
-
-        // Generate a key with the same byte size as the variable
-        _genKey();
+    // Setter, a read-modify-write operation already counted its access in _get()
+    void _set(const T &_val, const bool _bTouch = true) {
+        if (_bTouch)
+            _touch();
 
-        // If first run, update the m_bEmpty boolean
-        if (m_bEmpty) m_bEmpty = false;
+        // Release the previous value, and prepare the specifications and the key of the new one
+        _renew();
 
         // Packageing the byte array
         _copyVal(_val);
+
+        // Signal the change to the waiting threads
+        m_ui32Version.fetch_add(1, std::memory_order_release);
     }
 
     // Getter
     T _get() {
         // Throws an error if the user tries to get a value before initialization
+        _touch();
         if (m_bEmpty)
-            _set(T());
+            _set(T(), false);
 
         // Retrieve stored value and key specifications
         SspecsVal *ptrSpecsVal(reinterpret_cast<SspecsVal*>(_retrieveSpecs(Especs_::Especs_Val)));
@@ -437,23 +1303,57 @@ private:
             iKeyOffset(ptrSpecsKey->m_mvOffset.get()),
             iKeyReadOffset(ptrSpecsKey->m_mvReadOfsset.get());
 
-        // Cast the value and the key addresses integers to working pointers
-        uint8_t *ptrValBuff(_ptrUnfold(&ptrSpecsVal->m_mvPtr, &ptrSpecsVal->m_mvHopNbr)),
-                *ptrKeyBuff(_ptrUnfold(&ptrSpecsKey->m_mvPtr, &ptrSpecsKey->m_mvHopNbr));
+        // Cast the value and the key addresses integers to working pointers,
+        // the chains of the shadow copy are walked along with the main ones
+        uint8_t *ptrValBuff, *ptrKeyBuff,
+                *ptrShadowValBuff(nullptr), *ptrShadowKeyBuff(nullptr);
+        int iShadowSize(0);
+        if (m_ptrShadow == nullptr) {
+            ptrValBuff = _ptrUnfold(&ptrSpecsVal->m_mvPtr, &ptrSpecsVal->m_mvHopNbr);
+            ptrKeyBuff = _ptrUnfold(&ptrSpecsKey->m_mvPtr, &ptrSpecsKey->m_mvHopNbr);
+        }
+        else {
+            SshadowSpecs specsShadowVal(_shadowSpecs(m_ptrShadow->m_ui64ValPtr, m_ptrShadow->m_ui64ValSpecs)),
+                         specsShadowKey(_shadowSpecs(m_ptrShadow->m_ui64KeyPtr, m_ptrShadow->m_ui64KeySpecs));
+            _ptrUnfoldPair(&ptrSpecsVal->m_mvPtr, &ptrSpecsVal->m_mvHopNbr, &ptrValBuff,
+                           specsShadowVal.m_ptrHop, specsShadowVal.m_ui8HopNbr, &ptrShadowValBuff);
+            _ptrUnfoldPair(&ptrSpecsKey->m_mvPtr, &ptrSpecsKey->m_mvHopNbr, &ptrKeyBuff,
+                           specsShadowKey.m_ptrHop, specsShadowKey.m_ui8HopNbr, &ptrShadowKeyBuff);
+            ptrShadowValBuff += specsShadowVal.m_iOffset;
+            ptrShadowKeyBuff += specsShadowKey.m_iOffset;
+            iShadowSize = specsShadowVal.m_iSize;
+        }
         
         // Shift the pointer positions to their payloads
         ptrValBuff += iValOffset;
         ptrKeyBuff += iKeyOffset;
 
+        // Verify the obfuscated value has not been modified
+        _verifyVal(ptrValBuff, iValSize);
+
         // Retrieve the obfuscated value
         uint8_t *ui8ValBuff(new uint8_t[iValSize]);
         ::memset(ui8ValBuff, 0, iValSize);
         ::memcpy(ui8ValBuff, ptrValBuff, iValSize);
 
         // Proceed for each byte of the value to a xor logical operation with the key
-        for (uint8_t i(0); i < iValSize; ++i)
+        for (int i(0); i < iValSize; ++i)
             ui8ValBuff[i] ^= ptrKeyBuff[(iKeyReadOffset + i) % iKeySize];
 
+        // Compare with the shadow copy
+        if (m_ptrShadow != nullptr && (iShadowSize != iValSize || !_shadowMatch(ui8ValBuff, iValSize, ptrShadowValBuff, ptrShadowKeyBuff))) {
+            _wipe(ui8ValBuff, iValSize);
+            delete[] ui8ValBuff;
+            _reportTamper();
+        }
+
+        // Expand a compressed value
+        if (m_bCompressed) {
+            uint8_t *ui8PlainBuff(_expandVal(ui8ValBuff, &iValSize));
+            delete[] ui8ValBuff;
+            ui8ValBuff = ui8PlainBuff;
+        }
+
         // Cast the deobfuscated array to a variable of the expected type
         T val;
         _return<T>(&val, ui8ValBuff, iValSize);
@@ -466,6 +1366,241 @@ private:
     }
 
 
+    /*
+    ** Streaming Import
+    */
+
+    // Read chunks with the given function until it returns 0 (end) or less (error),
+    // directly into a new value memory buffer, obfuscating each of them once read
+    // The previous value is only replaced once the whole stream has been read
+    template <typename F>
+    size_t _assignFrom(F _fnRead) {
+        const std::lock_guard<std::mutex> lock(m_mtx);
+
+        // Without a previous value, start from an empty one so a key exists to obfuscate the chunks
+        if (m_bEmpty) {
+            _renew();
+            _allocVal(0);
+        }
+
+        // Memory buffer of the new value, starting with the noise sequence
+        int iValOffset(Smemory::spread(24) + 8),
+            iCapacity(iValOffset + s_iChunkSize * 4),
+            iSize(0);
+        std::unique_ptr<uint8_t[]> ui8ValBuff(new uint8_t[iCapacity]);
+        _copyVal_noisePadding(0, iValOffset, ui8ValBuff.get());
+
+        while (true) {
+            // Keep room for a chunk and the trailing noise, only obfuscated bytes are moved
+            if (iValOffset + iSize + s_iChunkSize + 32 > iCapacity) {
+                if (iCapacity > INT_MAX / 2)
+                    throw std::runtime_error("The value read from the stream is too large.");
+                std::unique_ptr<uint8_t[]> ui8ValBuffNew(new uint8_t[iCapacity * 2]);
+                ::memcpy(ui8ValBuffNew.get(), ui8ValBuff.get(), iValOffset + iSize);
+                ui8ValBuff = std::move(ui8ValBuffNew);
+                iCapacity *= 2;
+            }
+
+            // Read a chunk at its final position
+            uint8_t *ptrChunk(ui8ValBuff.get() + iValOffset + iSize);
+            int iRead(_fnRead(ptrChunk, s_iChunkSize));
+            if (iRead < 0)
+                throw std::runtime_error("Unable to read the value from the stream.");
+            if (iRead == 0)
+                break;
+
+            // Obfuscate the chunk right away, with the key of the previous value
+            _obfuscateVal(ptrChunk, iRead, iSize);
+            iSize += iRead;
+        }
+
+        // Populate the sequence after the value with random noise data
+        _copyVal_noisePadding(iValOffset + iSize, iValOffset + iSize + 8 + Smemory::spread(24), ui8ValBuff.get());
+
+        // Replace the previous value, its key is kept as the new value has been obfuscated with it
+        _flushVal();
+        uint8_t *ptrPayload(ui8ValBuff.get() + iValOffset);
+        _bindVal(ui8ValBuff.release(), iValOffset, iSize, iCapacity);
+        _sealVal(ptrPayload, iSize);
+        m_bCompressed = false;
+
+        // Signal the change to the waiting threads
+        m_ui32Version.fetch_add(1, std::memory_order_release);
+
+        return static_cast<size_t>(iSize);
+    }
+
+
+    /*
+    ** Streaming Export
+    */
+
+    // Deobfuscate the value by chunks into a stack buffer, and give each of them to the given function,
+    // until it returns false (error)
+    template <typename F>
+    size_t _writeTo(F _fnWrite) {
+        const std::lock_guard<std::mutex> lock(m_mtx);
+
+        // Same behavior as _get() before initialization
+        if (m_bEmpty)
+            _set(T());
+
+        // A compressed value is expanded in full, then written by chunks
+        if constexpr (std::is_same_v<T, std::string>) {
+            if (m_bCompressed) {
+                std::string strVal(_get());
+                bool bWritten(true);
+                for (size_t szPos(0); szPos < strVal.size() && bWritten; szPos += s_iChunkSize)
+                    bWritten = _fnWrite(reinterpret_cast<const uint8_t *>(strVal.data()) + szPos, static_cast<int>(std::min<size_t>(s_iChunkSize, strVal.size() - szPos)));
+                _wipe(reinterpret_cast<uint8_t *>(strVal.data()), static_cast<int>(strVal.size()));
+
+                if (!bWritten)
+                    throw std::runtime_error("Unable to write the value to the stream.");
+                return strVal.size();
+            }
+        }
+
+        // Retrieve the stored value
+        SspecsVal *ptrSpecsVal(reinterpret_cast<SspecsVal *>(_retrieveSpecs(Especs_::Especs_Val)));
+        int iValSize(ptrSpecsVal->m_mvSize.get()),
+            iValOffset(ptrSpecsVal->m_mvOffset.get());
+        const uint8_t *ptrValBuff(_ptrUnfold(&ptrSpecsVal->m_mvPtr, &ptrSpecsVal->m_mvHopNbr) + iValOffset);
+        _verifyVal(ptrValBuff, iValSize);
+
+        // Walk the chains of the shadow copy, as _get() does
+        const uint8_t *ptrShadowValBuff(nullptr), *ptrShadowKeyBuff(nullptr);
+        if (m_ptrShadow != nullptr) {
+            SshadowSpecs specsShadowVal(_shadowSpecs(m_ptrShadow->m_ui64ValPtr, m_ptrShadow->m_ui64ValSpecs)),
+                         specsShadowKey(_shadowSpecs(m_ptrShadow->m_ui64KeyPtr, m_ptrShadow->m_ui64KeySpecs));
+            if (specsShadowVal.m_iSize != iValSize)
+                _reportTamper();
+            ptrShadowValBuff = _ptrUnfold(specsShadowVal.m_ptrHop, specsShadowVal.m_ui8HopNbr) + specsShadowVal.m_iOffset;
+            ptrShadowKeyBuff = _ptrUnfold(specsShadowKey.m_ptrHop, specsShadowKey.m_ui8HopNbr) + specsShadowKey.m_iOffset;
+        }
+
+        uint8_t ui8Chunk[s_iChunkSize];
+        bool bWritten(true);
+        for (int iPos(0); iPos < iValSize && bWritten; iPos += s_iChunkSize) {
+            int iLen(std::min(s_iChunkSize, iValSize - iPos));
+
+            // Deobfuscate a single chunk, XOR with the key at the same position of the value
+            ::memcpy(ui8Chunk, ptrValBuff + iPos, iLen);
+            _obfuscateVal(ui8Chunk, iLen, iPos);
+
+            // Compare it with the shadow copy before handing it out
+            if (ptrShadowValBuff != nullptr && !_shadowMatch(ui8Chunk, iLen, ptrShadowValBuff + iPos, ptrShadowKeyBuff + iPos)) {
+                _wipe(ui8Chunk, s_iChunkSize);
+                _reportTamper();
+            }
+
+            bWritten = _fnWrite(ui8Chunk, iLen);
+        }
+
+        _wipe(ui8Chunk, s_iChunkSize);
+
+        if (!bWritten)
+            throw std::runtime_error("Unable to write the value to the stream.");
+
+        return static_cast<size_t>(iValSize);
+    }
+
+
+    /*
+    ** Persistence
+    */
+
+    // Export the stored value XORed with the given key instead of the instance key
+    bool _exportVal(std::vector<uint8_t> *_vecOut, const uint8_t *_ui8Key, const int _iKeySize) {
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        if (m_bEmpty)
+            return false;
+
+        // A compressed value is exported expanded, the importing instance may not compress
+        if constexpr (std::is_same_v<T, std::string>) {
+            if (m_bCompressed) {
+                std::string strVal(_get());
+                _vecOut->resize(strVal.size());
+                for (size_t i(0); i < strVal.size(); ++i)
+                    (*_vecOut)[i] = static_cast<uint8_t>(strVal[i]) ^ _ui8Key[i % _iKeySize];
+                _wipe(reinterpret_cast<uint8_t *>(strVal.data()), static_cast<int>(strVal.size()));
+                return true;
+            }
+        }
+
+        // Retrieve the stored value
+        SspecsVal *ptrSpecsVal(reinterpret_cast<SspecsVal *>(_retrieveSpecs(Especs_::Especs_Val)));
+        int iValSize(ptrSpecsVal->m_mvSize.get()),
+            iValOffset(ptrSpecsVal->m_mvOffset.get());
+        uint8_t *ptrValBuff(_ptrUnfold(&ptrSpecsVal->m_mvPtr, &ptrSpecsVal->m_mvHopNbr) + iValOffset);
+        _verifyVal(ptrValBuff, iValSize);
+
+        // Switch from the instance key to the given key
+        _vecOut->resize(iValSize);
+        _rekeyVal(ptrValBuff, _vecOut->data(), iValSize, _ui8Key, _iKeySize);
+        return true;
+    }
+
+    // Import a value XORed with the given key, and store it XORed with a new instance key
+    void _importVal(const uint8_t *_ui8Enc, const int _iSize, const uint8_t *_ui8Key, const int _iKeySize) {
+        // The payload comes from an external file, its size must match the stored type
+        if (!_isValidSize(_iSize))
+            throw std::runtime_error("The imported value size does not match the stored type.");
+
+        const std::lock_guard<std::mutex> lock(m_mtx);
+
+        // Same steps as _set(), the payload is never deobfuscated
+        _renew();
+
+        // Switch from the given key to the instance key
+        uint8_t *ui8Payload(_allocVal(_iSize));
+        _rekeyVal(_ui8Enc, ui8Payload, _iSize, _ui8Key, _iKeySize);
+        _sealVal(ui8Payload, _iSize);
+        m_bCompressed = false;
+
+        // Signal the change to the waiting threads
+        m_ui32Version.fetch_add(1, std::memory_order_release);
+    }
+
+
+    // Check if a payload size can be deobfuscated into the stored type
+    static bool _isValidSize(const int _iSize) {
+        if (_iSize < 0)
+            return false;
+        // Any length for a std::string
+        if constexpr (std::is_same_v<T, std::string>)
+            return true;
+        // A whole number of elements for a std::vector
+        else if constexpr (is_vector<T>::value)
+            return (_iSize % sizeof(typename T::value_type)) == 0;
+        // A whole number of pairs for a std::map
+        else if constexpr (is_map<T>::value)
+            return (_iSize % (sizeof(typename T::key_type) + sizeof(typename T::mapped_type))) == 0;
+        // The exact size of the other types
+        else if constexpr (std::is_trivially_copyable_v<T>)
+            return (_iSize == static_cast<int>(sizeof(T)));
+        else
+            return false;
+    }
+
+
+    /*
+    ** Comparison
+    */
+
+    // Compare two values of the stored type
+    bool _isEqual(const T &_vl, const T &_vr) {
+        // If the values are std::vector, std::map or std::string
+        if constexpr (is_vector<T>::value || is_map<T>::value || std::is_same_v<T, std::string>) {
+            return (_vl == _vr);
+        }
+        // If the values can be compared byte to byte
+        else {
+            int iSize(sizeof(T));
+            return (::memcmp(&_vl, &_vr, iSize) == 0);
+        }
+    }
+
+
     /*
     ** Core
     */
@@ -485,12 +1620,12 @@ private:
         if (!m_bPerfMode || m_bEmpty) {
             // Retrieve the offset between the pointer and position of the key
             // and the size of the key, and the allocated memory of the whole key package
-            int iKeyOffset(::rand() % 24 + 8),
+            int iKeyOffset(Smemory::spread(24) + 8),
                 iKeySize(::rand() % 32 + 32),
-                iAllocSize(iKeySize + iKeyOffset + 8 + ::rand() % 24),
+                iAllocSize(iKeySize + iKeyOffset + 8 + Smemory::spread(24)),
                 iReadOffset(::rand() % iKeySize);
             // Define a random number of element of the linked list of pointers (hops)
-            uint8_t ui8KeyHopNbr(::rand() % 7 + 1);
+            uint8_t ui8KeyHopNbr(_hopNbr());
 
             // Store in obfuscated variables those defined or calculated specifications
             SspecsKey *ptrSpecsKey(reinterpret_cast<SspecsKey*>(_retrieveSpecs(Especs_::Especs_Key)));
@@ -499,21 +1634,23 @@ private:
             ptrSpecsKey->m_mvHopNbr.set(ui8KeyHopNbr);
             ptrSpecsKey->m_mvReadOfsset.set(iReadOffset);
 
-            // Declare and initialize a dynamic array of bytes to store the key
-            uint8_t *ui8KeyBuff(new uint8_t[iAllocSize]);
-            ::memset(ui8KeyBuff, 0, iAllocSize);
+            // Declare and initialize a dynamic array of bytes to store the key, released if the hops can not be allocated
+            std::unique_ptr<uint8_t[]> ui8KeyBuff(new uint8_t[iAllocSize]);
+            ::memset(ui8KeyBuff.get(), 0, iAllocSize);
 
             // Populate the memory buffer with random values (whose a sequence will be used as a key)
             for (int i(0); i < iAllocSize; ++i)
                 ui8KeyBuff[i] = ::rand() % 256;
 
             // Create a linked list of pointers, the last pointing to the array of bytes
-            _ptrFold(ui8KeyHopNbr, &ptrSpecsKey->m_mvPtr, ui8KeyBuff);
+            _ptrFold(ui8KeyHopNbr, &ptrSpecsKey->m_mvPtr, ui8KeyBuff.get());
+            ui8KeyBuff.release();
+            _memReplace(&m_memKey, SmemoryUsage { 0, ui8KeyHopNbr * sizeof(intptr_t), static_cast<size_t>(iKeySize), 0, static_cast<size_t>(iAllocSize - iKeySize) });
         }
     }
 
     // Obfuscate a value in the format of an array of bytes
-    void _obfuscateVal(uint8_t *_ptrBuff, const int &_iValSize) {
+    void _obfuscateVal(uint8_t *_ptrBuff, const int &_iValSize, const int _iStart = 0) {
         // Retrieve the offset between the pointer and position of the key and the size of the key
         SspecsKey *ptrSpecsKey(reinterpret_cast<SspecsKey *>(_retrieveSpecs(Especs_::Especs_Key)));
         int iKeyOffset(ptrSpecsKey->m_mvOffset.get()),
@@ -523,9 +1660,26 @@ private:
         // Get a working pointer pointing to the key
         uint8_t *ui8KeyBuff(_ptrUnfold(&ptrSpecsKey->m_mvPtr, &ptrSpecsKey->m_mvHopNbr));
 
-        // Obfuscate the temporary byte array of the value
+        // Obfuscate the temporary byte array of the value, starting at the given position of the value
         for (int i(0); i < _iValSize; ++i)
-            _ptrBuff[i] ^= ui8KeyBuff[iKeyOffset + ((i + iKeyReadOffset) % iKeySize)];
+            _ptrBuff[i] ^= ui8KeyBuff[iKeyOffset + ((_iStart + i + iKeyReadOffset) % iKeySize)];
+    }
+
+    // XOR an array of bytes with both the instance key and another key,
+    // the value switches from one key to the other without being deobfuscated in memory
+    void _rekeyVal(const uint8_t *_ptrSrc, uint8_t *_ptrDst, const int _iSize, const uint8_t *_ui8Key, const int _iKeySize) {
+        // Retrieve the offset between the pointer and position of the key and the size of the key
+        SspecsKey *ptrSpecsKey(reinterpret_cast<SspecsKey *>(_retrieveSpecs(Especs_::Especs_Key)));
+        int iKeyOffset(ptrSpecsKey->m_mvOffset.get()),
+            iKeySize(ptrSpecsKey->m_mvSize.get()),
+            iKeyReadOffset(ptrSpecsKey->m_mvReadOfsset.get());
+
+        // Get a working pointer pointing to the key
+        uint8_t *ui8KeyBuff(_ptrUnfold(&ptrSpecsKey->m_mvPtr, &ptrSpecsKey->m_mvHopNbr));
+
+        // Combine both keys before applying them
+        for (int i(0); i < _iSize; ++i)
+            _ptrDst[i] = _ptrSrc[i] ^ (ui8KeyBuff[iKeyOffset + ((i + iKeyReadOffset) % iKeySize)] ^ _ui8Key[i % _iKeySize]);
     }
 
     // Process a value in the format of an array of bytes,
@@ -535,35 +1689,518 @@ private:
         // Calculate the size of the bytes of the value
         int iSize(_sizeVal<T>(_val));
 
-        // Define two random offset, and calculate the total size of the memory buffer
-        int iValOffset(::rand() % 24 + 8),
-            iValSize(iSize + iValOffset + 8 + ::rand() % 24);
-        // Define a random number of element of the linked list of pointers (hops)
-        uint8_t ui8ValHopNbr(::rand() % 7 + 1);
+        // Compress a large text value first, if it is worth it
+        m_bCompressed = false;
+        if constexpr (std::is_same_v<T, std::string>)
+            if (m_bCompression && iSize >= s_iCompressMinSize && _copyVal_compressed(_val, iSize))
+                return;
+
+        // Allocate the memory buffer of the value, and retrieve the position of the payload
+        uint8_t *ui8Payload(_allocVal(iSize));
+
+        // Cast the variable and store it into a byte array
+        _castVal<T>(_val, iSize, ui8Payload);
+
+        // Obfuscate the byte array
+        _obfuscateVal(ui8Payload, iSize);
+        _sealVal(ui8Payload, iSize);
+    }
+
+    // Compress a text value, and obfuscate it preceded by its expanded size,
+    // false if the compressed value is not at least a quarter smaller
+    bool _copyVal_compressed(const std::string &_str, const int _iSize) {
+        int iCapacity(_iSize - _iSize / 4);
+        std::unique_ptr<uint8_t[]> ui8CompBuff(new uint8_t[iCapacity]);
+        int iCompSize(Scompressor::compress(reinterpret_cast<const uint8_t *>(_str.data()), _iSize, ui8CompBuff.get(), iCapacity));
+        if (iCompSize > 0) {
+            uint8_t *ui8Payload(_allocVal(static_cast<int>(sizeof(uint32_t)) + iCompSize));
+            uint32_t ui32Size(static_cast<uint32_t>(_iSize));
+            ::memcpy(ui8Payload, &ui32Size, sizeof(uint32_t));
+            ::memcpy(ui8Payload + sizeof(uint32_t), ui8CompBuff.get(), iCompSize);
+            _obfuscateVal(ui8Payload, static_cast<int>(sizeof(uint32_t)) + iCompSize);
+            _sealVal(ui8Payload, static_cast<int>(sizeof(uint32_t)) + iCompSize);
+            m_bCompressed = true;
+        }
+        _wipe(ui8CompBuff.get(), iCapacity);
+        return m_bCompressed;
+    }
+
+    // Expand a deobfuscated compressed value into a new buffer, and update the size to the expanded one
+    uint8_t *_expandVal(const uint8_t *_ui8ValBuff, int *_iValSize) {
+        uint32_t ui32Size(0);
+        if (*_iValSize >= static_cast<int>(sizeof(uint32_t)))
+            ::memcpy(&ui32Size, _ui8ValBuff, sizeof(uint32_t));
+
+        std::unique_ptr<uint8_t[]> ui8PlainBuff(new uint8_t[ui32Size > INT_MAX ? 0 : ui32Size]);
+        if (ui32Size > INT_MAX
+            || !Scompressor::decompress(_ui8ValBuff + sizeof(uint32_t), *_iValSize - static_cast<int>(sizeof(uint32_t)), ui8PlainBuff.get(), static_cast<int>(ui32Size)))
+            throw std::runtime_error("The compressed value is corrupted.");
+
+        *_iValSize = static_cast<int>(ui32Size);
+        return ui8PlainBuff.release();
+    }
+
+    // Store the checksum and the shadow copy of the obfuscated value, once written
+    void _sealVal(const uint8_t *_ptrEnc, const int _iSize) {
+        if (m_bIntegrity)
+            m_ui64Checksum = Sintegrity::hash(_ptrEnc, _iSize, m_ui64ChecksumKey);
+        if (m_ptrShadow != nullptr)
+            _shadowBuild(_ptrEnc, _iSize);
+        // Record the specifications and every node of the hop chains, for the integrity scanner
+        if (m_bIntegrity || m_ptrShadow != nullptr)
+            _scanRecord();
+    }
+
+    // Throws an error if the obfuscated value does not match its checksum
+    void _verifyVal(const uint8_t *_ptrEnc, const int _iSize) {
+        if (m_bIntegrity && Sintegrity::hash(_ptrEnc, _iSize, m_ui64ChecksumKey) != m_ui64Checksum)
+            _reportTamper();
+    }
+
+    // Call the tamper function, and throw an error
+    [[noreturn]] void _reportTamper() {
+        void (*fnTamper)(const void *)(Sintegrity::s_fnTamper.load(std::memory_order_acquire));
+        if (fnTamper)
+            fnTamper(this);
+        throw std::runtime_error("The stored value has been tampered with.");
+    }
+
+
+    /*
+    ** Adaptive hops
+    */
+
+    // Number of hops of a new linked list of pointers, random or matching the heat of the instance,
+    // never more than the memory budget allows
+    uint8_t _hopNbr() {
+        if (!m_bAdaptiveHops)
+            return static_cast<uint8_t>(Smemory::spread(7) + 1);
+        double dHot(std::min(m_dHeat / s_dHeatHot, 1.0));
+        int iHopNbr(m_ui8HopMax - static_cast<int>(std::lround((m_ui8HopMax - m_ui8HopMin) * dHot)));
+        return static_cast<uint8_t>(std::min(iHopNbr, std::max(Smemory::range(7), 1)));
+    }
+
+    // Count an access, every s_iHeatPeriod accesses decay the heat by the elapsed half-lives
+    // The matching depth is only applied by the next write or relocation, a read never allocates
+    void _touch() {
+        if (!m_bAdaptiveHops || (++m_ui32Accesses % s_iHeatPeriod) != 0)
+            return;
+
+        std::chrono::steady_clock::time_point tpNow(std::chrono::steady_clock::now());
+        double dHalfLives(std::chrono::duration<double, std::milli>(tpNow - m_tpHeat).count() / s_dHeatHalfLifeMs);
+        m_dHeat  = m_dHeat * std::exp2(-dHalfLives) + s_iHeatPeriod;
+        m_tpHeat = tpNow;
+    }
+
+
+    /*
+    ** Relocation
+    */
+
+    // Type erased entry point of the relocation
+    static void _relocateEntry(void *_ptrInst, const bool _bReleaseFirst) {
+        static_cast<CvarObfuscated<T> *>(_ptrInst)->_relocate(_bReleaseFirst);
+    }
+
+    // Move the value to a new buffer under a new key, with new specifications and hop chains,
+    // the value goes through a random transit key and is never deobfuscated in memory
+    // The previous buffers are released first to let the new ones take their place,
+    // or last so the allocator can not hand the same addresses back
+    void _relocate(const bool _bReleaseFirst) {
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        _relocateVal(_bReleaseFirst);
+    }
+
+    // Same as _relocate(), the instance mutex being already locked
+    void _relocateVal(const bool _bReleaseFirst) {
+        if (m_bEmpty)
+            return;
 
-        // Store in obfuscated variables those defined or calculated specifications
         SspecsVal *ptrSpecsVal(reinterpret_cast<SspecsVal *>(_retrieveSpecs(Especs_::Especs_Val)));
-        ptrSpecsVal->m_mvOffset.set(iValOffset);
-        ptrSpecsVal->m_mvSize.set(iSize);
-        ptrSpecsVal->m_mvHopNbr.set(ui8ValHopNbr);
+        int iValSize(ptrSpecsVal->m_mvSize.get()),
+            iValOffset(ptrSpecsVal->m_mvOffset.get());
+        uint8_t *ptrValBuff(_ptrUnfold(&ptrSpecsVal->m_mvPtr, &ptrSpecsVal->m_mvHopNbr) + iValOffset);
+        _verifyVal(ptrValBuff, iValSize);
+
+        // Switch from the instance key to the transit key
+        uint8_t ui8TransitKey[s_iTransitKeySize];
+        for (int i(0); i < s_iTransitKeySize; ++i)
+            ui8TransitKey[i] = ::rand() % 256;
+        std::unique_ptr<uint8_t[]> ui8Transit(new uint8_t[std::max(iValSize, 1)]);
+        _rekeyVal(ptrValBuff, ui8Transit.get(), iValSize, ui8TransitKey, s_iTransitKeySize);
+
+        // Detach the previous specifications, key and value, or release them right away
+        SspecsKey *ptrSpecsKey(reinterpret_cast<SspecsKey *>(_retrieveSpecs(Especs_::Especs_Key)));
+        intptr_t *ptrValHop(reinterpret_cast<intptr_t *>(ptrSpecsVal->m_mvPtr.get())),
+                 *ptrKeyHop(reinterpret_cast<intptr_t *>(ptrSpecsKey->m_mvPtr.get())),
+                **arrVarAddr(m_arrVarAddr);
+        uint8_t ui8ValHopNbr(ptrSpecsVal->m_mvHopNbr.get()),
+                ui8KeyHopNbr(ptrSpecsKey->m_mvHopNbr.get()),
+               *arrConvert(m_arrConvert);
+        SmemoryUsage memSpecs(m_memSpecs),
+                     memKey(m_memKey),
+                     memVal(m_memVal);
+
+        // Build the new specifications, key and value buffer, as _renew() and _allocVal() do
+        uint8_t *ui8Payload(nullptr);
+        if (_bReleaseFirst) {
+            _renew();
+            ui8Payload = _allocVal(iValSize);
+        }
+        else {
+            // The previous value stays detached until the new one is complete, it is restored if an allocation fails
+            int iBuilt(0);
+            try {
+                m_bEmpty = true;
+                _alloc();
+                iBuilt = 1;
+                _genKey();
+                iBuilt = 2;
+                m_bEmpty = false;
+                ui8Payload = _allocVal(iValSize);
+            }
+            catch (...) {
+                if (iBuilt >= 2) {
+                    SspecsKey *ptrSpecsKeyNew(reinterpret_cast<SspecsKey *>(_retrieveSpecs(Especs_::Especs_Key)));
+                    _ptrFlush(&ptrSpecsKeyNew->m_mvPtr, &ptrSpecsKeyNew->m_mvHopNbr);
+                }
+                if (iBuilt >= 1)
+                    _flushSpecs(m_arrVarAddr, m_arrConvert);
+                m_arrVarAddr = arrVarAddr;
+                m_arrConvert = arrConvert;
+                m_bEmpty = false;
+                _memReplace(&m_memSpecs, memSpecs);
+                _memReplace(&m_memKey, memKey);
+                _memReplace(&m_memVal, memVal);
+                _wipe(ui8TransitKey, s_iTransitKeySize);
+                throw;
+            }
+        }
 
-        // Declare and initialize a dynamic array of bytes to store the obfuscated value
-        uint8_t *ui8ValBuff(new uint8_t[iValSize]);
-        ::memset(ui8ValBuff, 0, iValSize);
+        // Switch from the transit key to the new instance key
+        _rekeyVal(ui8Transit.get(), ui8Payload, iValSize, ui8TransitKey, s_iTransitKeySize);
+        _wipe(ui8TransitKey, s_iTransitKeySize);
+
+        // The new value is complete, the previous one is released once it is sealed (or failed to be),
+        // so the shadow copy can not take its addresses either
+        auto fnReleasePrevious([&]() {
+            if (_bReleaseFirst)
+                return;
+            _ptrFlush(ptrValHop, ui8ValHopNbr);
+            _ptrFlush(ptrKeyHop, ui8KeyHopNbr);
+            _flushSpecs(arrVarAddr, arrConvert);
+        });
+        try {
+            _sealVal(ui8Payload, iValSize);
+        }
+        catch (...) {
+            fnReleasePrevious();
+            throw;
+        }
+        fnReleasePrevious();
+    }
+
+
+    /*
+    ** Integrity scanner
+    */
+
+    // Join or leave the integrity scanner, depending on the checks enabled,
+    // the recorded digests are released when leaving it
+    void _scanUpdate() {
+        const std::lock_guard<std::mutex> lockRegistry(SscanRegistry::s_mtx);
+        {
+            const std::lock_guard<std::mutex> lock(m_mtx);
+            m_bScanned = (m_bIntegrity || m_ptrShadow != nullptr);
+            if (!m_bScanned && m_ptrScanRecord != nullptr) {
+                delete m_ptrScanRecord;
+                m_ptrScanRecord = nullptr;
+                _memReplace(&m_memScan, SmemoryUsage {});
+            }
+        }
+        if (m_bScanned)
+            SscanRegistry::s_mapEntries[this] = &_scanEntry;
+        else
+            SscanRegistry::s_mapEntries.erase(this);
+    }
+
+    // Type erased entry point of the scanner
+    static const char *_scanEntry(void *_ptrInst, size_t *_szBytes) {
+        return static_cast<CvarObfuscated<T> *>(_ptrInst)->_scan(_szBytes);
+    }
+
+    // Hop chains recorded for the integrity scanner
+    enum Echain_ : uint8_t {
+        Echain_Val,
+        Echain_Key,
+        Echain_ShadowVal,
+        Echain_ShadowKey
+    };
+
+    // Keyed digests of the specifications and of every node the hop chains go through, the last one being the buffer,
+    // recorded when the value is sealed so the scanner never follows an address it has not recorded
+    struct SscanRecord {
+        uint64_t    m_ui64Key           = 0,
+                    m_ui64Specs         = 0,
+                    m_ui64ShadowSpecs   = 0,
+                    m_ui64Nodes[4][8]   = {};   // By Echain_, up to 7 hops and the buffer
+    };
+
+    // Record the digests of the specifications and of the hop chains of the sealed value
+    void _scanRecord() {
+        if (m_ptrScanRecord == nullptr) {
+            m_ptrScanRecord = new SscanRecord();
+            m_ptrScanRecord->m_ui64Key = SrandomMask::gen();
+            _memReplace(&m_memScan, SmemoryUsage { sizeof(SscanRecord) });
+        }
+
+        SspecsVal *ptrSpecsVal(reinterpret_cast<SspecsVal *>(_retrieveSpecs(Especs_::Especs_Val)));
+        SspecsKey *ptrSpecsKey(reinterpret_cast<SspecsKey *>(_retrieveSpecs(Especs_::Especs_Key)));
+        uint8_t ui8ValHopNbr(ptrSpecsVal->m_mvHopNbr.get()),
+                ui8KeyHopNbr(ptrSpecsKey->m_mvHopNbr.get());
+        m_ptrScanRecord->m_ui64Specs = _scanDigest({ ptrSpecsVal->m_mvSize.get(), ptrSpecsVal->m_mvOffset.get(), ui8ValHopNbr,
+                                                     ptrSpecsKey->m_mvSize.get(), ptrSpecsKey->m_mvOffset.get(), ptrSpecsKey->m_mvReadOfsset.get(), ui8KeyHopNbr });
+        _scanRecordChain(Echain_::Echain_Val, reinterpret_cast<intptr_t *>(ptrSpecsVal->m_mvPtr.get()), ui8ValHopNbr);
+        _scanRecordChain(Echain_::Echain_Key, reinterpret_cast<intptr_t *>(ptrSpecsKey->m_mvPtr.get()), ui8KeyHopNbr);
+
+        if (m_ptrShadow != nullptr && m_ptrShadow->m_bBuilt) {
+            SshadowSpecs specsShadowVal(_shadowSpecs(m_ptrShadow->m_ui64ValPtr, m_ptrShadow->m_ui64ValSpecs)),
+                         specsShadowKey(_shadowSpecs(m_ptrShadow->m_ui64KeyPtr, m_ptrShadow->m_ui64KeySpecs));
+            m_ptrScanRecord->m_ui64ShadowSpecs = _scanDigest({ specsShadowVal.m_iSize, specsShadowVal.m_iOffset, specsShadowVal.m_ui8HopNbr,
+                                                               specsShadowKey.m_iSize, specsShadowKey.m_iOffset, specsShadowKey.m_ui8HopNbr });
+            _scanRecordChain(Echain_::Echain_ShadowVal, specsShadowVal.m_ptrHop, specsShadowVal.m_ui8HopNbr);
+            _scanRecordChain(Echain_::Echain_ShadowKey, specsShadowKey.m_ptrHop, specsShadowKey.m_ui8HopNbr);
+        }
+    }
+
+    // Record the digest of every node of a chain, and of the buffer it leads to
+    void _scanRecordChain(const Echain_ _eChain, intptr_t *_uiPtr, const uint8_t _ui8HopNbr) {
+        for (int i(0); i < _ui8HopNbr; ++i) {
+            m_ptrScanRecord->m_ui64Nodes[_eChain][i] = _scanDigest({ reinterpret_cast<intptr_t>(_uiPtr), _eChain, i });
+            _ptrUnfold_Walker(&_uiPtr);
+        }
+        m_ptrScanRecord->m_ui64Nodes[_eChain][_ui8HopNbr] = _scanDigest({ reinterpret_cast<intptr_t>(_uiPtr), _eChain, _ui8HopNbr });
+    }
+
+    // Check the specifications, the hop chains, the checksum and the shadow copy without deobfuscating the value,
+    // returns the reason of a violation or nullptr
+    const char *_scan(size_t *_szBytes) {
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        if (m_bEmpty || m_ptrScanRecord == nullptr)
+            return nullptr;
+
+        // Specifications as recorded, the sizes and offsets read below are those of the sealed buffers
+        SspecsVal *ptrSpecsVal(reinterpret_cast<SspecsVal *>(_retrieveSpecs(Especs_::Especs_Val)));
+        SspecsKey *ptrSpecsKey(reinterpret_cast<SspecsKey *>(_retrieveSpecs(Especs_::Especs_Key)));
+        int iValSize(ptrSpecsVal->m_mvSize.get()),
+            iValOffset(ptrSpecsVal->m_mvOffset.get()),
+            iKeySize(ptrSpecsKey->m_mvSize.get()),
+            iKeyOffset(ptrSpecsKey->m_mvOffset.get()),
+            iKeyReadOffset(ptrSpecsKey->m_mvReadOfsset.get());
+        uint8_t ui8ValHopNbr(ptrSpecsVal->m_mvHopNbr.get()),
+                ui8KeyHopNbr(ptrSpecsKey->m_mvHopNbr.get());
+        if (_scanDigest({ iValSize, iValOffset, ui8ValHopNbr, iKeySize, iKeyOffset, iKeyReadOffset, ui8KeyHopNbr }) != m_ptrScanRecord->m_ui64Specs)
+            return "The specifications have been modified.";
+
+        // Hop chains, every node is checked before being followed
+        uint8_t *ptrValBuff(_scanUnfold(Echain_::Echain_Val, reinterpret_cast<intptr_t *>(ptrSpecsVal->m_mvPtr.get()), ui8ValHopNbr)),
+                *ptrKeyBuff(_scanUnfold(Echain_::Echain_Key, reinterpret_cast<intptr_t *>(ptrSpecsKey->m_mvPtr.get()), ui8KeyHopNbr));
+        *_szBytes += (ui8ValHopNbr + ui8KeyHopNbr) * sizeof(intptr_t);
+        if (ptrValBuff == nullptr || ptrKeyBuff == nullptr)
+            return "A hop chain does not lead to the value or key buffer.";
+
+        // Checksum of the obfuscated value
+        if (m_bIntegrity) {
+            *_szBytes += iValSize;
+            if (Sintegrity::hash(ptrValBuff + iValOffset, iValSize, m_ui64ChecksumKey) != m_ui64Checksum)
+                return "The checksum does not match.";
+        }
+
+        // Shadow copy, both copies are compared with their keys applied, the differences are accumulated without branching
+        if (m_ptrShadow != nullptr && m_ptrShadow->m_bBuilt) {
+            SshadowSpecs specsShadowVal(_shadowSpecs(m_ptrShadow->m_ui64ValPtr, m_ptrShadow->m_ui64ValSpecs)),
+                         specsShadowKey(_shadowSpecs(m_ptrShadow->m_ui64KeyPtr, m_ptrShadow->m_ui64KeySpecs));
+            if (_scanDigest({ specsShadowVal.m_iSize, specsShadowVal.m_iOffset, specsShadowVal.m_ui8HopNbr,
+                              specsShadowKey.m_iSize, specsShadowKey.m_iOffset, specsShadowKey.m_ui8HopNbr }) != m_ptrScanRecord->m_ui64ShadowSpecs
+                || specsShadowVal.m_iSize != iValSize || specsShadowKey.m_iSize != iValSize)
+                return "The shadow specifications have been modified.";
+            uint8_t *ptrShadowValBuff(_scanUnfold(Echain_::Echain_ShadowVal, specsShadowVal.m_ptrHop, specsShadowVal.m_ui8HopNbr)),
+                    *ptrShadowKeyBuff(_scanUnfold(Echain_::Echain_ShadowKey, specsShadowKey.m_ptrHop, specsShadowKey.m_ui8HopNbr));
+            if (ptrShadowValBuff == nullptr || ptrShadowKeyBuff == nullptr)
+                return "A shadow hop chain is broken.";
+            ptrShadowValBuff += specsShadowVal.m_iOffset;
+            ptrShadowKeyBuff += specsShadowKey.m_iOffset;
+
+            uint8_t ui8Diff(0);
+            for (int i(0); i < iValSize; ++i)
+                ui8Diff |= ptrValBuff[iValOffset + i] ^ ptrKeyBuff[iKeyOffset + (iKeyReadOffset + i) % iKeySize] ^ ptrShadowValBuff[i] ^ ptrShadowKeyBuff[i];
+            *_szBytes += static_cast<size_t>(iValSize) * 3;
+            if (ui8Diff != 0)
+                return "The shadow copy does not match.";
+        }
+
+        return nullptr;
+    }
+
+    // Unravel a recorded linked list of pointers, checking every node and the buffer against their digests
+    // before following them, nullptr otherwise
+    uint8_t *_scanUnfold(const Echain_ _eChain, intptr_t *_uiPtr, const uint8_t _ui8HopNbr) {
+        if (_ui8HopNbr > 7)
+            return nullptr;
+        for (int i(0); i < _ui8HopNbr; ++i) {
+            if (_scanDigest({ reinterpret_cast<intptr_t>(_uiPtr), _eChain, i }) != m_ptrScanRecord->m_ui64Nodes[_eChain][i])
+                return nullptr;
+            _ptrUnfold_Walker(&_uiPtr);
+        }
+        if (_scanDigest({ reinterpret_cast<intptr_t>(_uiPtr), _eChain, _ui8HopNbr }) != m_ptrScanRecord->m_ui64Nodes[_eChain][_ui8HopNbr])
+            return nullptr;
+        return reinterpret_cast<uint8_t *>(_uiPtr);
+    }
+
+    // Digest of a set of integers, keyed per instance
+    uint64_t _scanDigest(const std::initializer_list<int64_t> _lstVal) const {
+        uint64_t ui64Ret(m_ptrScanRecord->m_ui64Key);
+        for (int64_t i64Val : _lstVal)
+            ui64Ret = ScompileTimeKey::mix(ui64Ret ^ static_cast<uint64_t>(i64Val));
+        return ui64Ret;
+    }
+
+
+    /*
+    ** Shadow copy
+    */
+
+    // Specifications of the shadow copy and of its key, only accessed under the instance mutex,
+    // masked with a single word renewed on every write
+    struct Sshadow {
+        uint64_t    m_ui64Msk       = 0,
+                    m_ui64ValPtr    = 0,    // Masked address of the first hop
+                    m_ui64ValSpecs  = 0,    // Masked offset, number of hops and size
+                    m_ui64KeyPtr    = 0,
+                    m_ui64KeySpecs  = 0;
+        bool        m_bBuilt        = false;
+    };
+
+    // Unmasked specifications of a shadow buffer
+    struct SshadowSpecs {
+        intptr_t   *m_ptrHop;
+        uint8_t     m_ui8HopNbr;
+        int         m_iOffset,
+                    m_iSize;
+    };
+
+    // Replace the shadow copy, switched from the instance key to a new shadow key without being deobfuscated
+    void _shadowBuild(const uint8_t *_ptrEnc, const int _iSize) {
+        _shadowFlush();
+        m_ptrShadow->m_ui64Msk = SrandomMask::gen();
+
+        // The shadow key is as long as the value, so both copies are compared without any modulo
+        SmemoryUsage usage;
+        uint8_t *ui8KeyPayload(_shadowAlloc(&m_ptrShadow->m_ui64KeyPtr, &m_ptrShadow->m_ui64KeySpecs, _iSize, &usage)),
+                *ui8ValPayload(_shadowAlloc(&m_ptrShadow->m_ui64ValPtr, &m_ptrShadow->m_ui64ValSpecs, _iSize, &usage));
+        usage.m_szKeys   = static_cast<size_t>(_iSize);
+        usage.m_szValues = static_cast<size_t>(_iSize);
+        usage.m_szSpecs  = sizeof(Sshadow);
+        _memReplace(&m_memShadow, usage);
+        for (int i(0); i < _iSize; ++i)
+            ui8KeyPayload[i] = ::rand() % 256;
+        _rekeyVal(_ptrEnc, ui8ValPayload, _iSize, ui8KeyPayload, std::max(_iSize, 1));
+        m_ptrShadow->m_bBuilt = true;
+    }
+
+    // Allocate a shadow memory buffer surrounded by noise, store its masked specifications,
+    // add its hops and padding to the given usage, and return the position of the payload
+    uint8_t *_shadowAlloc(uint64_t *_ui64Ptr, uint64_t *_ui64Specs, const int _iSize, SmemoryUsage *_usage) {
+        int iOffset(Smemory::spread(24) + 8),
+            iAllocSize(_iSize + iOffset + 8 + Smemory::spread(24));
+        uint8_t ui8HopNbr(_hopNbr());
+        _usage->m_szHops    += ui8HopNbr * sizeof(intptr_t);
+        _usage->m_szPadding += static_cast<size_t>(iAllocSize - _iSize);
+
+        uint8_t *ui8Buff(new uint8_t[iAllocSize]);
+        _copyVal_noisePadding(0, iAllocSize, ui8Buff);
+
+        // Offset, number of hops and size packed in a single word
+        *_ui64Ptr   = static_cast<uint64_t>(_ptrFold(ui8HopNbr, ui8Buff)) ^ m_ptrShadow->m_ui64Msk;
+        *_ui64Specs = (static_cast<uint64_t>(iOffset) | (static_cast<uint64_t>(ui8HopNbr) << 8) | (static_cast<uint64_t>(_iSize) << 16)) ^ m_ptrShadow->m_ui64Msk;
+
+        return ui8Buff + iOffset;
+    }
+
+    // Unmask the specifications of a shadow buffer
+    SshadowSpecs _shadowSpecs(const uint64_t _ui64Ptr, const uint64_t _ui64Specs) const {
+        uint64_t ui64Specs(_ui64Specs ^ m_ptrShadow->m_ui64Msk);
+        return SshadowSpecs {
+            reinterpret_cast<intptr_t *>(static_cast<intptr_t>(_ui64Ptr ^ m_ptrShadow->m_ui64Msk)),
+            static_cast<uint8_t>(ui64Specs >> 8),
+            static_cast<int>(ui64Specs & 0xFF),
+            static_cast<int>(ui64Specs >> 16)
+        };
+    }
+
+    // Release the shadow buffers and their linked lists of pointers
+    void _shadowFlush() {
+        if (m_ptrShadow == nullptr || !m_ptrShadow->m_bBuilt)
+            return;
+        SshadowSpecs specsVal(_shadowSpecs(m_ptrShadow->m_ui64ValPtr, m_ptrShadow->m_ui64ValSpecs)),
+                     specsKey(_shadowSpecs(m_ptrShadow->m_ui64KeyPtr, m_ptrShadow->m_ui64KeySpecs));
+        _ptrFlush(specsVal.m_ptrHop, specsVal.m_ui8HopNbr);
+        _ptrFlush(specsKey.m_ptrHop, specsKey.m_ui8HopNbr);
+        m_ptrShadow->m_bBuilt = false;
+        _memReplace(&m_memShadow, SmemoryUsage { sizeof(Sshadow) });
+    }
+
+    // Compare a deobfuscated value with the shadow copy, without branching on each byte
+    static bool _shadowMatch(const uint8_t *_ui8Plain, const int _iSize, const uint8_t *_ptrShadowVal, const uint8_t *_ptrShadowKey) {
+        uint8_t ui8Diff(0);
+        for (int i(0); i < _iSize; ++i)
+            ui8Diff |= _ui8Plain[i] ^ _ptrShadowVal[i] ^ _ptrShadowKey[i];
+        return (ui8Diff == 0);
+    }
+
+    // Wipe a plain buffer through a volatile pointer, the compiler can not discard the writes
+    static void _wipe(uint8_t *_ui8Buff, const int _iSize) {
+        volatile uint8_t *ptrBuff(_ui8Buff);
+        for (int i(0); i < _iSize; ++i)
+            ptrBuff[i] = 0;
+    }
+
+    // Allocate the memory buffer of a value surrounded by noise, define its specifications,
+    // and return the position of the payload
+    uint8_t *_allocVal(const int _iSize) {
+        // Define two random offset, and calculate the total size of the memory buffer
+        int iValOffset(Smemory::spread(24) + 8),
+            iValSize(_iSize + iValOffset + 8 + Smemory::spread(24));
+
+        // Declare and initialize a dynamic array of bytes to store the obfuscated value, released if the hops can not be allocated
+        std::unique_ptr<uint8_t[]> ui8ValBuff(new uint8_t[iValSize]);
+        ::memset(ui8ValBuff.get(), 0, iValSize);
 
         // Populate the sequence before the value with random noise data
-        _copyVal_noisePadding(0, iValOffset, ui8ValBuff);
+        _copyVal_noisePadding(0, iValOffset, ui8ValBuff.get());
         // Populate the sequence after the value with random noise data
-        _copyVal_noisePadding(iValOffset + iValSize, iSize, ui8ValBuff);
+        _copyVal_noisePadding(iValOffset + _iSize, iValSize, ui8ValBuff.get());
 
-        // Cast the variable and store it into a byte array
-        _castVal<T>(_val, iSize, ui8ValBuff + iValOffset);
+        // Store the specifications and the address of the memory buffer
+        _bindVal(ui8ValBuff.get(), iValOffset, _iSize, iValSize);
 
-        // Obfuscate the byte array
-        _obfuscateVal(ui8ValBuff + iValOffset, iSize);
+        return ui8ValBuff.release() + iValOffset;
+    }
+
+    // Store the specifications of a value memory buffer, and create the linked list of pointers to it
+    void _bindVal(uint8_t *_ui8ValBuff, const int _iValOffset, const int _iSize, const int _iAllocSize) {
+        // Define a random number of element of the linked list of pointers (hops)
+        uint8_t ui8ValHopNbr(_hopNbr());
+
+        // Store in obfuscated variables those defined or calculated specifications
+        SspecsVal *ptrSpecsVal(reinterpret_cast<SspecsVal *>(_retrieveSpecs(Especs_::Especs_Val)));
+        ptrSpecsVal->m_mvOffset.set(_iValOffset);
+        ptrSpecsVal->m_mvSize.set(_iSize);
+        ptrSpecsVal->m_mvHopNbr.set(ui8ValHopNbr);
 
         // Create a linked list of pointers, the last pointing to the array of bytes
-        _ptrFold(ui8ValHopNbr, &ptrSpecsVal->m_mvPtr, ui8ValBuff);
+        _ptrFold(ui8ValHopNbr, &ptrSpecsVal->m_mvPtr, _ui8ValBuff);
+        _memReplace(&m_memVal, SmemoryUsage { 0, ui8ValHopNbr * sizeof(intptr_t), 0, static_cast<size_t>(_iSize), static_cast<size_t>(_iAllocSize - _iSize) });
     }
 
     // Populate the value buffer with padding noise data sequence
@@ -575,6 +2212,11 @@ private:
     // Create a linked list of pointers with several hops,
     // from the stored address to the memory buffer of the value or key
     void _ptrFold(uint8_t _ui8HopNbr, CvarMasked<intptr_t> *_mvVal, uint8_t *_ui8ptrBuff) {
+        _mvVal->set(_ptrFold(_ui8HopNbr, _ui8ptrBuff));
+    }
+
+    // Create a linked list of pointers with several hops, and return the address of its first element
+    intptr_t _ptrFold(uint8_t _ui8HopNbr, uint8_t *_ui8ptrBuff) {
         // Declare and initialize the keeper of the last element of the linked list
         intptr_t addHopLast(0);
 
@@ -582,44 +2224,81 @@ private:
         // actually the beginning of the linked list
         intptr_t *ptrHopLast(new intptr_t);
 
-        // Retrieve and store the memory address of the first element of the linked list
+        // Retrieve the memory address of the first element of the linked list
         addHopLast = reinterpret_cast<intptr_t>(ptrHopLast);
-        _mvVal->set(addHopLast);
+        intptr_t addHopFirst(addHopLast);
 
         // For the number of hops defined before
-        for (int i(0); i < _ui8HopNbr - 1; ++i) {
-            // Declare and initialize a new pointer
-            intptr_t *ptrTemp(new intptr_t);
-            // Update the pointer address of the last element of the linked list with the new created
-            ptrHopLast = reinterpret_cast<intptr_t *>(addHopLast);
-            // Temporary store the new last element address
-            intptr_t addHopLastNew(reinterpret_cast<intptr_t>(ptrTemp));
-            // Store the difference between the two last pointers addresses
-            *ptrHopLast = addHopLast - addHopLastNew;
-            // Update the stored address of the last element of the linked list with the new created
-            addHopLast = addHopLastNew;
+        int iLinked(1);
+        try {
+            for (int i(0); i < _ui8HopNbr - 1; ++i) {
+                // Declare and initialize a new pointer
+                intptr_t *ptrTemp(new intptr_t);
+                // Update the pointer address of the last element of the linked list with the new created
+                ptrHopLast = reinterpret_cast<intptr_t *>(addHopLast);
+                // Temporary store the new last element address
+                intptr_t addHopLastNew(reinterpret_cast<intptr_t>(ptrTemp));
+                // Store the difference between the two last pointers addresses
+                *ptrHopLast = addHopLast - addHopLastNew;
+                // Update the stored address of the last element of the linked list with the new created
+                addHopLast = addHopLastNew;
+                ++iLinked;
+            }
+        }
+        catch (...) {
+            // Release the elements already linked if an allocation fails
+            intptr_t *ptrHop(reinterpret_cast<intptr_t *>(addHopFirst));
+            for (int i(0); i < iLinked; ++i) {
+                intptr_t *ptrDel(ptrHop);
+                if (i + 1 < iLinked)
+                    _ptrUnfold_Walker(&ptrHop);
+                delete ptrDel;
+            }
+            throw;
         }
 
         // Get the last node
         intptr_t *ptrTempLast(reinterpret_cast<intptr_t *>(addHopLast));
         // Make it pointing to the array of bytes of the value or key
         *ptrTempLast = addHopLast - reinterpret_cast<intptr_t>(_ui8ptrBuff);
+
+        return addHopFirst;
     }
 
     // Unravel the linked list of pointers with several hops,
     // from the stored address to the memory buffer of the value or key
     uint8_t *_ptrUnfold(CvarMasked<intptr_t> *_mvPtr, CvarMasked<uint8_t> *_mvHopNbr) {
-        // Declare and initialize the pointer used to unfold the linked list of pointers
-        intptr_t *uiPtr(reinterpret_cast<intptr_t *>(_mvPtr->get()));
-        // Retrieve the number of hops
-        uint8_t ui8HopNbr(_mvHopNbr->get());
+        return _ptrUnfold(reinterpret_cast<intptr_t *>(_mvPtr->get()), _mvHopNbr->get());
+    }
 
+    // Unravel the linked list of pointers starting at the given address
+    uint8_t *_ptrUnfold(intptr_t *_uiPtr, const uint8_t _ui8HopNbr) {
         // Jump from a pointer to another, the memory buffer value is the jump length
-        for (int i(0); i < ui8HopNbr; ++i)
-            _ptrUnfold_Walker(&uiPtr);
+        for (int i(0); i < _ui8HopNbr; ++i)
+            _ptrUnfold_Walker(&_uiPtr);
 
         // Return the last pointer of the linked list
-        return reinterpret_cast<uint8_t *>(uiPtr);
+        return reinterpret_cast<uint8_t *>(_uiPtr);
+    }
+
+    // Unravel two linked lists of pointers together, one hop of each per step,
+    // so the loads of one list overlap the memory latency of the other
+    void _ptrUnfoldPair(CvarMasked<intptr_t> *_mvPtrA, CvarMasked<uint8_t> *_mvHopNbrA, uint8_t **_ptrA,
+                        intptr_t *_uiPtrB, const uint8_t _ui8HopNbrB, uint8_t **_ptrB) {
+        intptr_t *uiPtrA(reinterpret_cast<intptr_t *>(_mvPtrA->get())),
+                 *uiPtrB(_uiPtrB);
+        uint8_t ui8HopNbrA(_mvHopNbrA->get()),
+                ui8HopNbrB(_ui8HopNbrB);
+
+        for (int i(0); i < std::max(ui8HopNbrA, ui8HopNbrB); ++i) {
+            if (i < ui8HopNbrA)
+                _ptrUnfold_Walker(&uiPtrA);
+            if (i < ui8HopNbrB)
+                _ptrUnfold_Walker(&uiPtrB);
+        }
+
+        *_ptrA = reinterpret_cast<uint8_t *>(uiPtrA);
+        *_ptrB = reinterpret_cast<uint8_t *>(uiPtrB);
     }
 
     // Jump from a pointer address to another
@@ -660,9 +2339,14 @@ private:
             return;
 
         // Allocate the array containing all specifications masked vars memory addresses,
-        // and the array to translate a type name into an index
-        m_arrVarAddr = new intptr_t * [4];
-        m_arrConvert = new uint8_t[4];
+        // the array to translate a type name into an index, and the specifications,
+        // all of them released if one of the allocations fails
+        std::unique_ptr<intptr_t *[]> arrVarAddr(new intptr_t * [4]);
+        std::unique_ptr<uint8_t[]> arrConvert(new uint8_t[4]);
+        std::unique_ptr<SspecsVal> ptrSpecsVal(new SspecsVal());
+        std::unique_ptr<SspecsKey> ptrSpecsKey(new SspecsKey());
+        m_arrVarAddr = arrVarAddr.release();
+        m_arrConvert = arrConvert.release();
         ::memset(m_arrConvert, 255, sizeof(uint8_t) * 4);
 
         // Array used create a random of Especs_ specifications variables order
@@ -689,19 +2373,15 @@ private:
             switch (i) {
                 case Especs_::Especs_Val:
                 {
-                    // Allocate a new set of masked specifications var for the value
-                    SspecsVal *ptrNew(new SspecsVal());
-                    // Store the address of this new masked var set
-                    m_arrVarAddr[ui8IndexSelect] = reinterpret_cast<intptr_t *>(ptrNew);
+                    // Store the address of the new set of masked specifications var for the value
+                    m_arrVarAddr[ui8IndexSelect] = reinterpret_cast<intptr_t *>(ptrSpecsVal.release());
                 }
                 break;
 
                 case Especs_::Especs_Key:
                 {
-                    // Allocate a new set of masked specifications var for the key
-                    SspecsKey *ptrNew(new SspecsKey());
-                    // Store the address of this new masked var set
-                    m_arrVarAddr[ui8IndexSelect] = reinterpret_cast<intptr_t *>(ptrNew);
+                    // Store the address of the new set of masked specifications var for the key
+                    m_arrVarAddr[ui8IndexSelect] = reinterpret_cast<intptr_t *>(ptrSpecsKey.release());
                 }
                 break;
 
@@ -720,6 +2400,8 @@ private:
                 break;
             }
         }
+
+        _memReplace(&m_memSpecs, SmemoryUsage { sizeof(intptr_t *) * 4 + sizeof(uint8_t) * 4 + sizeof(SspecsVal) + sizeof(SspecsKey) });
     }
 
     // Reset all value's and key's specifications, and release their memory buffers
@@ -727,38 +2409,72 @@ private:
         // If already populated
         if (!m_bEmpty || (_bForce && !m_bEmpty)) {
             // Unfold the linked list, release every hops, and release the value or key buffer
-            SspecsVal *ptrSpecsVal(reinterpret_cast<SspecsVal *>(_retrieveSpecs(Especs_::Especs_Val)));
-            _ptrFlush(&ptrSpecsVal->m_mvPtr, &ptrSpecsVal->m_mvHopNbr);
+            _flushVal();
             if (!m_bPerfMode || _bForce) {
                 SspecsKey *ptrSpecsKey(reinterpret_cast<SspecsKey *>(_retrieveSpecs(Especs_::Especs_Key)));
                 _ptrFlush(&ptrSpecsKey->m_mvPtr, &ptrSpecsKey->m_mvHopNbr);
 
-                // Release all specifications data buffers and remove fake addresses
-                for (int i(0); i < 4; ++i)
-                    if (m_arrConvert[i] == Especs_::Especs_Val
-                        || m_arrConvert[i] == Especs_::Especs_Key)
-                        delete m_arrVarAddr[i];
-                    else
-                        m_arrVarAddr[i] = nullptr;
-
-                // Release the specification masked var address randomizer
-                delete[] m_arrVarAddr;
-                delete[] m_arrConvert;
+                _flushSpecs(m_arrVarAddr, m_arrConvert);
+                _memReplace(&m_memSpecs, SmemoryUsage {});
+                _memReplace(&m_memKey, SmemoryUsage {});
             }
         }
     }
 
-    // Release every hops of the linked list, and the memory buffer of the value
-    void _ptrFlush(CvarMasked<intptr_t> *_mvPtr, CvarMasked<uint8_t> *_mvHopNbr) {
-        // Declare and initialize the pointer used to unfold the linked list of pointers
-        intptr_t *uiPtrCurr(reinterpret_cast<intptr_t *>(_mvPtr->get()));
-        // Retrieve the number of hops
-        uint8_t ui8HopNbr(_mvHopNbr->get());
+    // Release the specifications of a value and a key, and their address randomizer
+    void _flushSpecs(intptr_t **_arrVarAddr, uint8_t *_arrConvert) {
+        // Release all specifications data buffers and remove fake addresses
+        for (int i(0); i < 4; ++i)
+            if (_arrConvert[i] == Especs_::Especs_Val
+                || _arrConvert[i] == Especs_::Especs_Key)
+                delete _arrVarAddr[i];
+            else
+                _arrVarAddr[i] = nullptr;
+
+        // Release the specification masked var address randomizer
+        delete[] _arrVarAddr;
+        delete[] _arrConvert;
+    }
 
-        // Jump from a pointer to another
-        for (uint8_t i(0); i < ui8HopNbr; ++i) {
-            // Store the current address to a temporary pointer
-            intptr_t *uiptrDel(uiPtrCurr);
+    // Release the value memory buffer and its linked list of pointers, the key is kept
+    void _flushVal() {
+        SspecsVal *ptrSpecsVal(reinterpret_cast<SspecsVal *>(_retrieveSpecs(Especs_::Especs_Val)));
+        _ptrFlush(&ptrSpecsVal->m_mvPtr, &ptrSpecsVal->m_mvHopNbr);
+        _memReplace(&m_memVal, SmemoryUsage {});
+    }
+
+    // Replace the usage of an allocation slot, and update the global accounting
+    void _memReplace(SmemoryUsage *_usageSlot, const SmemoryUsage &_usage) {
+        Smemory::replace(*_usageSlot, _usage);
+        *_usageSlot = _usage;
+    }
+
+    // Release the previous value and key, allocate the specifications and generate a new key
+    void _renew() {
+        // If not empty, erase all data and dynamic arrays
+        _flush();
+
+        // Allocate the dynamic variables to store the value's and key's specifications
+        _alloc();
+
+        // Generate a key with the same byte size as the variable
+        _genKey();
+
+        // If first run, update the m_bEmpty boolean
+        if (m_bEmpty) m_bEmpty = false;
+    }
+
+    // Release every hops of the linked list, and the memory buffer of the value
+    void _ptrFlush(CvarMasked<intptr_t> *_mvPtr, CvarMasked<uint8_t> *_mvHopNbr) {
+        _ptrFlush(reinterpret_cast<intptr_t *>(_mvPtr->get()), _mvHopNbr->get());
+    }
+
+    // Release every hops of the linked list starting at the given address, and the memory buffer it points to
+    void _ptrFlush(intptr_t *uiPtrCurr, const uint8_t ui8HopNbr) {
+        // Jump from a pointer to another
+        for (uint8_t i(0); i < ui8HopNbr; ++i) {
+            // Store the current address to a temporary pointer
+            intptr_t *uiptrDel(uiPtrCurr);
             // Go to the next pointer
             _ptrUnfold_Walker(&uiPtrCurr);
             // Release the memory of the temporary pointer
@@ -951,13 +2667,72 @@ private:
     ** Member variables
     */
 
-    std::mutex          m_mtx;
-    std::atomic<bool>   m_bEmpty     = true;
-    bool                m_bPerfMode  = false;
-    intptr_t          **m_arrVarAddr = nullptr;
-    uint8_t            *m_arrConvert = nullptr;
+    static constexpr int    s_iChunkSize        = 4096;
+    static constexpr int    s_iCompressMinSize  = 512;
+    static constexpr int    s_iTransitKeySize   = 64;
+    static constexpr int    s_iHeatPeriod       = 64;       // Accesses between two heat updates
+    static constexpr double s_dHeatHalfLifeMs   = 100.,
+                            s_dHeatHot          = 4096.;    // Heat of the shallowest chains
+
+    std::mutex              m_mtx;
+    uint64_t                m_ui64PersistId     = 0;
+    std::atomic<bool>       m_bEmpty            = true;
+    std::atomic<uint32_t>   m_ui32Version       = 0;
+    bool                    m_bPerfMode         = false;
+    bool                    m_bCompression      = false,    // Compress the next values (std::string only)
+                            m_bCompressed       = false,    // The stored value is compressed
+                            m_bIntegrity        = false;    // Verify the checksum on every read
+    uint64_t                m_ui64ChecksumKey   = 0,
+                            m_ui64Checksum      = 0;
+    Sshadow                *m_ptrShadow         = nullptr;  // Redundant storage (see set_redundancy())
+    bool                    m_bScanned          = false,    // Registered in the integrity scanner
+                            m_bRelocatable      = false;    // Registered in the relocation (see set_relocation())
+    SscanRecord            *m_ptrScanRecord     = nullptr;  // Digests of the hop chains (see _scanRecord())
+    bool                    m_bAdaptiveHops     = false;    // Hops matching the heat (see set_adaptive_hops())
+    uint8_t                 m_ui8HopMin         = 1,
+                            m_ui8HopMax         = 7;
+    uint32_t                m_ui32Accesses      = 0;
+    double                  m_dHeat             = 0;        // Decaying number of accesses
+    std::chrono::steady_clock::time_point m_tpHeat;
+    SmemoryUsage            m_memSpecs,                     // Heap bytes of each allocation slot (see memory_usage())
+                            m_memKey,
+                            m_memVal,
+                            m_memShadow,
+                            m_memScan;
+    intptr_t              **m_arrVarAddr        = nullptr;
+    uint8_t                *m_arrConvert        = nullptr;
 };
 
+// Write an obfuscated string of characters to an output stream, by chunks (see CvarObfuscated<T>::write_to())
+inline std::ostream &operator<<(std::ostream &_os, CvarObfuscated<std::string> &_ov) {
+    _ov.write_to(_os);
+    return _os;
+}
+
+#if defined(__cpp_lib_format)
+namespace std {
+    // Format an obfuscated string of characters, by chunks, without format specification (i.e. "{}")
+    template <>
+    struct formatter<CvarObfuscated<std::string>, char> {
+        constexpr auto parse(std::format_parse_context &_ctx) {
+            if (_ctx.begin() != _ctx.end() && *_ctx.begin() != '}')
+                throw std::format_error("An obfuscated string does not support format specifications.");
+            return _ctx.begin();
+        }
+
+        template <typename FormatContext>
+        auto format(CvarObfuscated<std::string> &_ov, FormatContext &_ctx) const {
+            auto itOut(_ctx.out());
+            _ov._writeTo([&](const uint8_t *_ptrSrc, const int _iLen) -> bool {
+                itOut = std::copy(_ptrSrc, _ptrSrc + _iLen, itOut);
+                return true;
+            });
+            return itOut;
+        }
+    };
+}
+#endif
+
 template <>
 class CvarObfuscated<void> {
 public:
@@ -968,4 +2743,1577 @@ public:
             ::srand(seed);
         }
     }
+
+    // Define the function called with the instance address when a value has been tampered with (see CvarObfuscated<T>::set_integrity()),
+    // the error is thrown once it returns
+    static void set_tamper_callback(void (*_fnTamper)(const void *)) {
+        Sintegrity::s_fnTamper.store(_fnTamper, std::memory_order_release);
+    }
+
+
+    /*
+    ** Memory
+    */
+
+    // Heap bytes currently held by every instance, split by purpose
+    static SmemoryUsage memory_usage() {
+        return Smemory::global();
+    }
+
+    // Define a global budget in bytes, 0 for none, the random padding and hop ranges of the next encodings
+    // shrink linearly from three quarters of the budget, down to a single hop and the minimal padding
+    static void set_memory_budget(const size_t _szBytes) {
+        Smemory::s_szBudget.store(_szBytes, std::memory_order_relaxed);
+    }
+
+
+    /*
+    ** Profiling
+    * Filled when MESCAMIT_PROFILE is defined before including this header (see Sprofiler)
+    */
+
+    // Write the call sites sorted by cumulated time, the operators being located by their return address
+    static void profile_report(std::ostream &_os) {
+#if defined(MESCAMIT_PROFILE)
+        std::vector<const Sprofiler::Sslot *> vecSlots;
+        for (const Sprofiler::Sslot &slot : Sprofiler::s_arrSlots)
+            if (slot.m_bReady.load(std::memory_order_acquire) && slot.m_ui64Calls.load(std::memory_order_relaxed) != 0)
+                vecSlots.push_back(&slot);
+        std::sort(vecSlots.begin(), vecSlots.end(), [](const Sprofiler::Sslot *_a, const Sprofiler::Sslot *_b) {
+            return _a->m_ui64Nanos.load(std::memory_order_relaxed) > _b->m_ui64Nanos.load(std::memory_order_relaxed);
+        });
+
+        _os << std::setw(12) << "calls" << std::setw(14) << "total us" << std::setw(10) << "mean ns" << "  operator, type, call site\n";
+        for (const Sprofiler::Sslot *ptrSlot : vecSlots) {
+            uint64_t ui64Calls(ptrSlot->m_ui64Calls.load(std::memory_order_relaxed)),
+                     ui64Nanos(ptrSlot->m_ui64Nanos.load(std::memory_order_relaxed));
+            _os << std::setw(12) << ui64Calls << std::setw(14) << ui64Nanos / 1000 << std::setw(10) << ui64Nanos / ui64Calls
+                << "  " << ptrSlot->m_szOperator << ", " << ptrSlot->m_szType << ", ";
+            if (ptrSlot->m_szFile != nullptr)
+                _os << ptrSlot->m_szFile << ":" << ptrSlot->m_ui32Line << " (" << ptrSlot->m_szFunction << ")\n";
+            else
+                _os << "return address " << ptrSlot->m_ptrAddr << "\n";
+        }
+        if (Sprofiler::s_ui64Dropped.load(std::memory_order_relaxed) != 0)
+            _os << Sprofiler::s_ui64Dropped.load(std::memory_order_relaxed) << " calls not counted, the table is full\n";
+#else
+        _os << "Profiling disabled, define MESCAMIT_PROFILE before including CvarObfuscated.hpp\n";
+#endif
+    }
+
+    // Reset the counters, the call sites are kept
+    static void profile_reset() {
+#if defined(MESCAMIT_PROFILE)
+        for (Sprofiler::Sslot &slot : Sprofiler::s_arrSlots) {
+            slot.m_ui64Calls.store(0, std::memory_order_relaxed);
+            slot.m_ui64Nanos.store(0, std::memory_order_relaxed);
+        }
+        Sprofiler::s_ui64Dropped.store(0, std::memory_order_relaxed);
+#endif
+    }
+
+
+    /*
+    ** Trimming
+    * Every relocatable instance (see CvarObfuscated<T>::set_relocation()) is moved to fresh allocations,
+    * the previous buffers being released first, the allocator then returns its free pages to the system
+    */
+
+    // Relocate every relocatable instance and release the free heap pages, returns the number of instances relocated
+    static size_t trim() {
+        size_t szRelocated(0);
+        {
+            const std::lock_guard<std::mutex> lock(SrelocRegistry::s_mtx);
+            for (const auto &[ptrInst, fnRelocate] : SrelocRegistry::s_mapEntries) {
+                fnRelocate(ptrInst, true);
+                ++szRelocated;
+            }
+        }
+
+        // MADV_DONTNEED on the free pages of every arena
+#if defined(_WIN32)
+        ::_heapmin();
+#elif defined(__GLIBC__)
+        ::malloc_trim(0);
+#endif
+        return szRelocated;
+    }
+
+    // Run trim() on a background thread once no value has been written for the given duration,
+    // a single time per idle period, trim_stop() must be called before exiting
+    static void trim_start(const std::chrono::milliseconds _msIdle) {
+        trim_stop();
+        {
+            const std::lock_guard<std::mutex> lock(SrelocRegistry::s_mtxThread);
+            SrelocRegistry::s_bStop = false;
+        }
+        SrelocRegistry::s_thread = std::thread([_msIdle]() {
+            uint64_t ui64Activity(Smemory::s_ui64Activity.load(std::memory_order_relaxed));
+            bool bTrimmed(false);
+            std::unique_lock<std::mutex> lock(SrelocRegistry::s_mtxThread);
+            while (!SrelocRegistry::s_cvThread.wait_for(lock, _msIdle, [] { return SrelocRegistry::s_bStop; })) {
+                uint64_t ui64ActivityNew(Smemory::s_ui64Activity.load(std::memory_order_relaxed));
+                if (ui64ActivityNew != ui64Activity)
+                    bTrimmed = false;
+                else if (!bTrimmed) {
+                    lock.unlock();
+                    trim();
+                    lock.lock();
+                    bTrimmed = true;
+                    // The relocation itself is not an activity
+                    ui64ActivityNew = Smemory::s_ui64Activity.load(std::memory_order_relaxed);
+                }
+                ui64Activity = ui64ActivityNew;
+            }
+        });
+    }
+
+    // Stop the idle trimmer, and wait for its thread
+    static void trim_stop() {
+        {
+            const std::lock_guard<std::mutex> lock(SrelocRegistry::s_mtxThread);
+            SrelocRegistry::s_bStop = true;
+        }
+        SrelocRegistry::s_cvThread.notify_all();
+        if (SrelocRegistry::s_thread.joinable())
+            SrelocRegistry::s_thread.join();
+    }
+
+
+    /*
+    ** Relocation
+    * The relocatable instances are moved in turn to fresh addresses, so a memory scanner which found
+    * a buffer can not keep watching it, a pass resumes where the previous one stopped
+    */
+
+    // Move the next instances until the duration exceeds its budget,
+    // at least one instance and at most every instance once, returns the number of instances moved
+    static size_t relocate_step(const std::chrono::microseconds _usTimeBudget) {
+        std::chrono::steady_clock::time_point tpEnd(std::chrono::steady_clock::now() + _usTimeBudget);
+        size_t szMoved(0);
+
+        const std::lock_guard<std::mutex> lock(SrelocRegistry::s_mtx);
+        size_t szCount(SrelocRegistry::s_mapEntries.size());
+        while (szMoved < szCount) {
+            // Next instance after the cursor, wrapping around
+            auto itEntry(SrelocRegistry::s_mapEntries.upper_bound(SrelocRegistry::s_ptrCursor));
+            if (itEntry == SrelocRegistry::s_mapEntries.end())
+                itEntry = SrelocRegistry::s_mapEntries.begin();
+            SrelocRegistry::s_ptrCursor = itEntry->first;
+
+            itEntry->second(itEntry->first, false);
+            ++szMoved;
+
+            if (std::chrono::steady_clock::now() >= tpEnd)
+                break;
+        }
+        return szMoved;
+    }
+
+    // Run relocate_step() on a background thread at the given period, relocate_stop() must be called before exiting
+    static void relocate_start(const std::chrono::milliseconds _msPeriod, const std::chrono::microseconds _usTimeBudget) {
+        relocate_stop();
+        {
+            const std::lock_guard<std::mutex> lock(SrelocRegistry::s_mtxMover);
+            SrelocRegistry::s_bMoverStop = false;
+        }
+        SrelocRegistry::s_threadMover = std::thread([_msPeriod, _usTimeBudget]() {
+            std::unique_lock<std::mutex> lock(SrelocRegistry::s_mtxMover);
+            while (!SrelocRegistry::s_cvMover.wait_for(lock, _msPeriod, [] { return SrelocRegistry::s_bMoverStop; })) {
+                lock.unlock();
+                relocate_step(_usTimeBudget);
+                lock.lock();
+            }
+        });
+    }
+
+    // Stop the background relocation, and wait for its thread
+    static void relocate_stop() {
+        {
+            const std::lock_guard<std::mutex> lock(SrelocRegistry::s_mtxMover);
+            SrelocRegistry::s_bMoverStop = true;
+        }
+        SrelocRegistry::s_cvMover.notify_all();
+        if (SrelocRegistry::s_threadMover.joinable())
+            SrelocRegistry::s_threadMover.join();
+    }
+
+
+    /*
+    ** Integrity scanner
+    * Every instance with an integrity check or a redundant storage enabled is checked in turn,
+    * a pass resumes where the previous one stopped and locks a single instance at a time
+    */
+
+    // Define the function called with the instance address and the reason of a violation found by the scanner,
+    // it is called once the scanner locks are released
+    static void set_scan_callback(void (*_fnViolation)(const void *, const char *)) {
+        SscanRegistry::s_fnViolation.store(_fnViolation, std::memory_order_release);
+    }
+
+    // Check the next instances until the number of bytes read or the duration exceeds its budget,
+    // at least one instance and at most every instance once, returns the number of instances checked
+    static size_t scan_step(const size_t _szByteBudget, const std::chrono::microseconds _usTimeBudget) {
+        std::chrono::steady_clock::time_point tpEnd(std::chrono::steady_clock::now() + _usTimeBudget);
+        std::vector<std::pair<const void *, const char *>> vecViolations;
+        size_t szBytes(0),
+               szChecked(0);
+        {
+            const std::lock_guard<std::mutex> lock(SscanRegistry::s_mtx);
+            size_t szCount(SscanRegistry::s_mapEntries.size());
+            while (szChecked < szCount) {
+                // Next instance after the cursor, wrapping around
+                auto itEntry(SscanRegistry::s_mapEntries.upper_bound(SscanRegistry::s_ptrCursor));
+                if (itEntry == SscanRegistry::s_mapEntries.end())
+                    itEntry = SscanRegistry::s_mapEntries.begin();
+                SscanRegistry::s_ptrCursor = itEntry->first;
+
+                const char *szReason(itEntry->second(itEntry->first, &szBytes));
+                if (szReason != nullptr)
+                    vecViolations.emplace_back(itEntry->first, szReason);
+                ++szChecked;
+
+                if (szBytes >= _szByteBudget || std::chrono::steady_clock::now() >= tpEnd)
+                    break;
+            }
+        }
+
+        // Report the violations
+        void (*fnViolation)(const void *, const char *)(SscanRegistry::s_fnViolation.load(std::memory_order_acquire));
+        if (fnViolation)
+            for (const auto &[ptrInst, szReason] : vecViolations)
+                fnViolation(ptrInst, szReason);
+
+        return szChecked;
+    }
+
+    // Run scan_step() on a background thread at the given period, scan_stop() must be called before exiting
+    static void scan_start(const std::chrono::milliseconds _msPeriod, const size_t _szByteBudget, const std::chrono::microseconds _usTimeBudget) {
+        scan_stop();
+        {
+            const std::lock_guard<std::mutex> lock(SscanRegistry::s_mtxThread);
+            SscanRegistry::s_bStop = false;
+        }
+        SscanRegistry::s_thread = std::thread([_msPeriod, _szByteBudget, _usTimeBudget]() {
+            std::unique_lock<std::mutex> lock(SscanRegistry::s_mtxThread);
+            while (!SscanRegistry::s_cvThread.wait_for(lock, _msPeriod, [] { return SscanRegistry::s_bStop; })) {
+                lock.unlock();
+                scan_step(_szByteBudget, _usTimeBudget);
+                lock.lock();
+            }
+        });
+    }
+
+    // Stop the background scanner, and wait for its thread
+    static void scan_stop() {
+        {
+            const std::lock_guard<std::mutex> lock(SscanRegistry::s_mtxThread);
+            SscanRegistry::s_bStop = true;
+        }
+        SscanRegistry::s_cvThread.notify_all();
+        if (SscanRegistry::s_thread.joinable())
+            SscanRegistry::s_thread.join();
+    }
+
+
+    /*
+    ** Persistence
+    * Every persisted instance (see CvarObfuscated<T>::persist()) is saved with its obfuscated bytes,
+    * switched from the instance key to a file key without being deobfuscated
+    * The file key of each value is derived from the key given by the caller, a random NONCE and the value ID,
+    * the key given by the caller is never written in the file
+    *
+    *     +-------+---------+-------+--------+------+-------+-----+--------+
+    *     | MAGIC | VERSION | NONCE | ID     | SIZE | VALUE | ... | ID = 0 |
+    *     +-------+---------+-------+--------+------+-------+-----+--------+
+    *       4       4         8       8        4      SIZE          8
+    */
+
+    // Save every persisted value to a file, returns the number of values saved
+    static size_t snapshot(const std::string &_strPath, const uint64_t _ui64Key) {
+        uint64_t ui64Nonce(SrandomMask::gen());
+
+        // Export every persisted value, the file is written once the registry is released
+        std::vector<Sentry> vecEntries;
+        {
+            uint8_t ui8FileKey[s_iFileKeySize];
+            const std::lock_guard<std::mutex> lock(SpersistRegistry::s_mtx);
+            for (const auto &[ui64Id, entry] : SpersistRegistry::s_mapEntries) {
+                Sentry entryOut { ui64Id, {} };
+                _genFileKey(ui8FileKey, _ui64Key, ui64Nonce, ui64Id);
+                if (entry.m_fnExport(entry.m_ptrInst, &entryOut.m_vecVal, ui8FileKey, s_iFileKeySize))
+                    vecEntries.push_back(std::move(entryOut));
+            }
+            _wipe(ui8FileKey, s_iFileKeySize);
+        }
+
+        // Open the file with a large stream buffer, so it is written by chunks
+        std::vector<char> vecStreamBuff(s_szChunkSize);
+        std::ofstream ofs;
+        ofs.rdbuf()->pubsetbuf(vecStreamBuff.data(), vecStreamBuff.size());
+        ofs.open(_strPath, std::ios::binary | std::ios::trunc);
+        if (!ofs)
+            throw std::runtime_error("Unable to open the snapshot file.");
+
+        // Header
+        ofs.write(reinterpret_cast<const char *>(&s_ui32FileMagic), sizeof(uint32_t));
+        ofs.write(reinterpret_cast<const char *>(&s_ui32FileVersion), sizeof(uint32_t));
+        ofs.write(reinterpret_cast<const char *>(&ui64Nonce), sizeof(uint64_t));
+
+        // Every persisted value
+        for (const Sentry &entry : vecEntries) {
+            uint32_t ui32Size(static_cast<uint32_t>(entry.m_vecVal.size()));
+            ofs.write(reinterpret_cast<const char *>(&entry.m_ui64Id), sizeof(uint64_t));
+            ofs.write(reinterpret_cast<const char *>(&ui32Size), sizeof(uint32_t));
+            ofs.write(reinterpret_cast<const char *>(entry.m_vecVal.data()), ui32Size);
+        }
+
+        // End of the list
+        uint64_t ui64End(0);
+        ofs.write(reinterpret_cast<const char *>(&ui64End), sizeof(uint64_t));
+
+        ofs.close();
+        if (!ofs)
+            throw std::runtime_error("Unable to write the snapshot file.");
+        return vecEntries.size();
+    }
+
+    // Restore the persisted values from a file, with the key given to snapshot(),
+    // returns the number of values restored
+    static size_t restore(const std::string &_strPath, const uint64_t _ui64Key) {
+        // Open the file with a large stream buffer, so it is read by chunks
+        std::vector<char> vecStreamBuff(s_szChunkSize);
+        std::ifstream ifs;
+        ifs.rdbuf()->pubsetbuf(vecStreamBuff.data(), vecStreamBuff.size());
+        ifs.open(_strPath, std::ios::binary);
+        if (!ifs)
+            throw std::runtime_error("Unable to open the snapshot file.");
+
+        // Header
+        uint32_t ui32Magic(0),
+                 ui32Version(0);
+        uint64_t ui64Nonce(0);
+        ifs.read(reinterpret_cast<char *>(&ui32Magic), sizeof(uint32_t));
+        ifs.read(reinterpret_cast<char *>(&ui32Version), sizeof(uint32_t));
+        ifs.read(reinterpret_cast<char *>(&ui64Nonce), sizeof(uint64_t));
+        if (!ifs || ui32Magic != s_ui32FileMagic || ui32Version != s_ui32FileVersion)
+            throw std::runtime_error("Invalid snapshot file.");
+
+        // Every saved value, until the end of the list
+        std::vector<Sentry> vecEntries;
+        while (true) {
+            Sentry entry;
+            uint32_t ui32Size(0);
+            ifs.read(reinterpret_cast<char *>(&entry.m_ui64Id), sizeof(uint64_t));
+            if (!ifs)
+                throw std::runtime_error("Truncated snapshot file.");
+            if (entry.m_ui64Id == 0)
+                break;
+
+            ifs.read(reinterpret_cast<char *>(&ui32Size), sizeof(uint32_t));
+            if (!ifs || ui32Size > static_cast<uint32_t>(INT_MAX))
+                throw std::runtime_error("Invalid snapshot file.");
+            entry.m_vecVal.resize(ui32Size);
+            ifs.read(reinterpret_cast<char *>(entry.m_vecVal.data()), ui32Size);
+            if (!ifs)
+                throw std::runtime_error("Truncated snapshot file.");
+
+            vecEntries.push_back(std::move(entry));
+        }
+
+        const std::lock_guard<std::mutex> lock(SpersistRegistry::s_mtx);
+
+        // Check every value before restoring any of them, values without a live instance are skipped
+        for (const Sentry &entry : vecEntries) {
+            auto itInst(SpersistRegistry::s_mapEntries.find(entry.m_ui64Id));
+            if (itInst != SpersistRegistry::s_mapEntries.end()
+                && !itInst->second.m_fnIsValidSize(static_cast<int>(entry.m_vecVal.size())))
+                throw std::runtime_error("A snapshot value size does not match its persisted type.");
+        }
+
+        size_t szCount(0);
+        uint8_t ui8FileKey[s_iFileKeySize];
+        for (const Sentry &entry : vecEntries) {
+            auto itInst(SpersistRegistry::s_mapEntries.find(entry.m_ui64Id));
+            if (itInst == SpersistRegistry::s_mapEntries.end())
+                continue;
+
+            _genFileKey(ui8FileKey, _ui64Key, ui64Nonce, entry.m_ui64Id);
+            itInst->second.m_fnImport(itInst->second.m_ptrInst, entry.m_vecVal.data(), static_cast<int>(entry.m_vecVal.size()), ui8FileKey, s_iFileKeySize);
+            ++szCount;
+        }
+        _wipe(ui8FileKey, s_iFileKeySize);
+
+        return szCount;
+    }
+
+private:
+    // Saved value
+    struct Sentry {
+        uint64_t             m_ui64Id = 0;
+        std::vector<uint8_t> m_vecVal;
+    };
+
+    // Derive the file key of a value from the key given by the caller, the file nonce and the value ID
+    static void _genFileKey(uint8_t *_ui8FileKey, const uint64_t _ui64Key, const uint64_t _ui64Nonce, const uint64_t _ui64Id) {
+        uint64_t ui64Seed(ScompileTimeKey::mix(_ui64Key ^ ScompileTimeKey::mix(_ui64Nonce ^ ScompileTimeKey::mix(_ui64Id))));
+        for (int i(0); i < s_iFileKeySize; i += 8) {
+            uint64_t ui64Word(ScompileTimeKey::keyWord(ui64Seed, i / 8));
+            ::memcpy(_ui8FileKey + i, &ui64Word, 8);
+        }
+    }
+
+    // Wipe a key, the compiler can not discard the writes
+    static void _wipe(uint8_t *_ui8Buff, const int _iSize) {
+        volatile uint8_t *ptrBuff(_ui8Buff);
+        for (int i(0); i < _iSize; ++i)
+            ptrBuff[i] = 0;
+    }
+
+    static constexpr uint32_t s_ui32FileMagic   = 0x4D43534D; // "MSCM"
+    static constexpr uint32_t s_ui32FileVersion = 2;
+    static constexpr int      s_iFileKeySize    = 64;
+    static constexpr size_t   s_szChunkSize     = 64 * 1024;
+};
+
+
+/*
+** CstrDecoded
+* Deobfuscated copy of a string literal, stored on the stack and wiped when leaving the scope
+*/
+
+template <size_t N>
+class CstrDecoded {
+public:
+    // Destructor
+    ~CstrDecoded() {
+        // Wipe the plain text through a volatile pointer, the compiler can not discard the writes
+        volatile char *ptrStr(m_arrStr);
+        for (size_t i(0); i < N; ++i)
+            ptrStr[i] = '\0';
+    }
+
+    // Null terminated string of characters
+    const char *c_str() const {
+        return m_arrStr;
+    }
+
+    // Length of the string, without the terminating null character
+    size_t size() const {
+        return N - 1;
+    }
+
+    // View of the string
+    std::string_view view() const {
+        return std::string_view(m_arrStr, N - 1);
+    }
+
+private:
+    template <size_t, uint64_t> friend class CstrObfuscated;
+
+    char m_arrStr[N];
+};
+
+
+/*
+** CstrObfuscated
+* String literal obfuscated at compile time, only the XORed bytes are stored in the binary
+* Use the MESCAMIT_STR("...") macro rather than this class directly
+*/
+
+template <size_t N, uint64_t Seed>
+class CstrObfuscated {
+public:
+    // Constructor, evaluated by the compiler only
+    consteval CstrObfuscated(const char (&_str)[N]) {
+        for (size_t i(0); i < N; ++i)
+            m_arrEnc[i] = static_cast<uint8_t>(_str[i]) ^ ScompileTimeKey::keyByte(Seed, i);
+    }
+
+    // Deobfuscate the string literal into a stack buffer
+    CstrDecoded<N> decode() const {
+        CstrDecoded<N> strRet;
+
+        // Read the obfuscated bytes through a volatile pointer,
+        // so the compiler can not fold the decoding back into the plain text
+        const uint8_t *volatile ptrEnc(m_arrEnc);
+        ScompileTimeKey::xorKey<Seed>(ptrEnc, reinterpret_cast<uint8_t *>(strRet.m_arrStr), N);
+
+        return strRet;
+    }
+
+private:
+    uint8_t m_arrEnc[N] {};
+};
+
+// Obfuscate a string literal at compile time, and deobfuscate it on demand into a stack buffer
+#define MESCAMIT_STR(_str) ([]() { \
+        static constexpr CstrObfuscated<sizeof(_str), MESCAMIT_SEED> s_strObf(_str); \
+        return s_strObf.decode(); \
+    }())
+
+
+/*
+** CvarObfuscatedConst
+* Constant obfuscated at compile time, without mutex nor dynamic allocation
+* Can be declared in static storage, as it is constant initialized
+* Use the MESCAMIT_CONST(type, value) macro rather than this class directly
+*/
+
+template <typename T, uint64_t Seed>
+class CvarObfuscatedConst {
+    static_assert(std::is_trivially_copyable_v<T>, "CvarObfuscatedConst requires a trivially copyable type.");
+
+public:
+    // Constructor, evaluated by the compiler only
+    consteval CvarObfuscatedConst(const T &_val) {
+        std::array<uint8_t, sizeof(T)> arrVal(std::bit_cast<std::array<uint8_t, sizeof(T)>>(_val));
+        for (size_t i(0); i < sizeof(T); ++i)
+            m_arrVal[i] = arrVal[i] ^ ScompileTimeKey::keyByte(Seed, i);
+    }
+
+    // Getter
+    T get() const {
+        // Read the obfuscated bytes through a volatile pointer,
+        // so the compiler can not fold the decoding back into the plain value
+        const uint8_t *volatile ptrVal(m_arrVal);
+
+        uint8_t ui8ValBuff[sizeof(T)];
+        ScompileTimeKey::xorKey<Seed>(ptrVal, ui8ValBuff, sizeof(T));
+
+        T val;
+        ::memcpy(&val, ui8ValBuff, sizeof(T));
+        return val;
+    }
+
+    // Getter
+    operator T() const {
+        return get();
+    }
+
+private:
+    uint8_t m_arrVal[sizeof(T)] {};
 };
+
+// Obfuscate a constant value at compile time
+#define MESCAMIT_CONST(_type, _val) (CvarObfuscatedConst<_type, MESCAMIT_SEED>(_val))
+
+
+/*
+** CvarObfuscatedWord
+* Obfuscate a value up to 8 bytes (e.g. booleans, enums, flags) without mutex nor dynamic allocation
+* The masked value and its mask are two words guarded by a sequence lock, the mask is renewed on every write
+*/
+
+template <typename T>
+class CvarObfuscatedWord {
+    static_assert(sizeof(T) <= 8 && std::is_trivially_copyable_v<T>, "CvarObfuscatedWord requires a trivially copyable type up to 8 bytes.");
+
+public:
+    // Constructors
+    CvarObfuscatedWord() {
+        _modify([](uint64_t) { return _toWord(T()); });
+    }
+
+    CvarObfuscatedWord(const T &_val) {
+        _modify([&](uint64_t) { return _toWord(_val); });
+    }
+
+    CvarObfuscatedWord(const CvarObfuscatedWord &) = delete;
+    CvarObfuscatedWord &operator=(const CvarObfuscatedWord &) = delete;
+
+    // Getter
+    operator T() const {
+        return _fromWord(_read());
+    }
+
+
+    /*
+    ** Assignment Operators
+    */
+
+    // = Assignation
+    T operator=(const T &_val) {
+        _modify([&](uint64_t) { return _toWord(_val); });
+        return _val;
+    }
+
+
+    /*
+    ** Atomic Operations
+    */
+
+    // Retrieve the value
+    T load() const {
+        return _fromWord(_read());
+    }
+
+    // Replace the value
+    void store(const T &_val) {
+        _modify([&](uint64_t) { return _toWord(_val); });
+    }
+
+    // Replace the value, and return the previous one
+    T exchange(const T &_val) {
+        return _fromWord(_modify([&](uint64_t) { return _toWord(_val); }));
+    }
+
+    // Replace the value with the desired one if it is equal to the expected one,
+    // otherwise the expected one is updated with the actual value
+    bool compare_exchange_strong(T &_expected, const T &_desired) {
+        uint64_t ui64Expected(_toWord(_expected)),
+                 ui64Old(_modify([&](uint64_t _ui64) { return (_ui64 == ui64Expected ? _toWord(_desired) : _ui64); }));
+        if (ui64Old == ui64Expected)
+            return true;
+        _expected = _fromWord(ui64Old);
+        return false;
+    }
+
+    // Add to the value, and return the previous one
+    T fetch_add(const T &_val) {
+        return _fromWord(_modify([&](uint64_t _ui64) { return _toWord(static_cast<T>(_fromWord(_ui64) + _val)); }));
+    }
+
+    // Subtract from the value, and return the previous one
+    T fetch_sub(const T &_val) {
+        return _fromWord(_modify([&](uint64_t _ui64) { return _toWord(static_cast<T>(_fromWord(_ui64) - _val)); }));
+    }
+
+
+    /*
+    ** Arithmetic Compound Assignment Operators
+    */
+
+    // += Addition
+    T operator += (const T &_val) {
+        return static_cast<T>(fetch_add(_val) + _val);
+    }
+
+    // -= Subtraction
+    T operator -= (const T &_val) {
+        return static_cast<T>(fetch_sub(_val) - _val);
+    }
+
+
+    /*
+    ** Increment and Decrement Operators
+    */
+
+    // ++ Increment prefix
+    T operator ++ () {
+        return static_cast<T>(fetch_add(1) + 1);
+    }
+
+    // ++ Increment postfix
+    T operator ++ (int) {
+        return fetch_add(1);
+    }
+
+    // -- Decrement prefix
+    T operator -- () {
+        return static_cast<T>(fetch_sub(1) - 1);
+    }
+
+    // -- Decrement postfix
+    T operator -- (int) {
+        return fetch_sub(1);
+    }
+
+
+    /**
+    ** Bitwise Compound Assignment Operators
+    */
+
+    // &= Bitwise Compound Assignment AND
+    T operator &= (const T &_iMask) {
+        return _fromWord(_modify([&](uint64_t _ui64) { return _ui64 & _toWord(_iMask); }) & _toWord(_iMask));
+    }
+
+    // |= Bitwise Compound Assignment OR
+    T operator |= (const T &_iMask) {
+        return _fromWord(_modify([&](uint64_t _ui64) { return _ui64 | _toWord(_iMask); }) | _toWord(_iMask));
+    }
+
+    // ^= Bitwise Compound Assignment XOR, done on the masked value without deobfuscating it
+    T operator ^= (const T &_iMask) {
+        uint32_t ui32Seq(_lock());
+        uint64_t ui64Msk(m_ui64Msk.load(std::memory_order_relaxed)),
+                 ui64MskNew(_genMask());
+        // (value ^ mask) ^ iMask == (value ^ iMask ^ mask ^ maskNew) ^ maskNew
+        uint64_t ui64Val(m_ui64Val.load(std::memory_order_relaxed) ^ _toWord(_iMask) ^ ui64Msk ^ ui64MskNew);
+        m_ui64Val.store(ui64Val, std::memory_order_relaxed);
+        m_ui64Msk.store(ui64MskNew, std::memory_order_relaxed);
+        _unlock(ui32Seq);
+        return _fromWord(ui64Val ^ ui64MskNew);
+    }
+
+
+    /*
+    ** Relational Operators
+    */
+
+    // == Is equal to, compared in the masked domain
+    bool operator == (const T &_vr) const {
+        uint64_t ui64Val, ui64Msk;
+        _readMasked(&ui64Val, &ui64Msk);
+        return (ui64Val == (_toWord(_vr) ^ ui64Msk));
+    }
+
+    // != Not equal to
+    bool operator != (const T &_vr) const {
+        return !(*this == _vr);
+    }
+
+private:
+    /*
+    ** Sequence lock
+    */
+
+    // Read a consistent pair of masked value and mask
+    void _readMasked(uint64_t *_ui64Val, uint64_t *_ui64Msk) const {
+        while (true) {
+            uint32_t ui32Seq(m_ui32Seq.load(std::memory_order_acquire));
+            // A writer is in progress
+            if (ui32Seq & 1)
+                continue;
+
+            *_ui64Val = m_ui64Val.load(std::memory_order_relaxed);
+            *_ui64Msk = m_ui64Msk.load(std::memory_order_relaxed);
+
+            // Retry if a writer has modified the pair meanwhile
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_ui32Seq.load(std::memory_order_relaxed) == ui32Seq)
+                return;
+        }
+    }
+
+    // Read the deobfuscated word
+    uint64_t _read() const {
+        uint64_t ui64Val, ui64Msk;
+        _readMasked(&ui64Val, &ui64Msk);
+        return ui64Val ^ ui64Msk;
+    }
+
+    // Acquire the writer side of the sequence lock (odd sequence number)
+    uint32_t _lock() {
+        uint32_t ui32Seq(m_ui32Seq.load(std::memory_order_relaxed));
+        while ((ui32Seq & 1) || !m_ui32Seq.compare_exchange_weak(ui32Seq, ui32Seq + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            ui32Seq = m_ui32Seq.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return ui32Seq + 1;
+    }
+
+    // Release the writer side of the sequence lock (even sequence number)
+    void _unlock(const uint32_t _ui32Seq) {
+        m_ui32Seq.store(_ui32Seq + 1, std::memory_order_release);
+    }
+
+    // Replace the word by the result of the given function, with a new mask,
+    // and return the previous deobfuscated word
+    template <typename F>
+    uint64_t _modify(F _fnUpdate) {
+        uint32_t ui32Seq(_lock());
+        uint64_t ui64Old(m_ui64Val.load(std::memory_order_relaxed) ^ m_ui64Msk.load(std::memory_order_relaxed)),
+                 ui64Msk(_genMask());
+        m_ui64Val.store(_fnUpdate(ui64Old) ^ ui64Msk, std::memory_order_relaxed);
+        m_ui64Msk.store(ui64Msk, std::memory_order_relaxed);
+        _unlock(ui32Seq);
+        return ui64Old;
+    }
+
+
+    /*
+    ** Core
+    */
+
+    // Generate a new mask
+    static uint64_t _genMask() {
+        return SrandomMask::gen();
+    }
+
+    // Cast a value to a word
+    static uint64_t _toWord(const T &_val) {
+        uint64_t ui64(0);
+        ::memcpy(&ui64, &_val, sizeof(T));
+        return ui64;
+    }
+
+    // Cast a word to a value
+    static T _fromWord(const uint64_t _ui64) {
+        T val;
+        ::memcpy(&val, &_ui64, sizeof(T));
+        return val;
+    }
+
+
+    /*
+    ** Member variables
+    */
+
+    std::atomic<uint32_t>   m_ui32Seq = 0;
+    std::atomic<uint64_t>   m_ui64Val = 0,  // Stored masked value
+                            m_ui64Msk = 0;  // Stored mask
+};
+
+
+/*
+** CvarObfuscatedBitset
+* Obfuscate a set of N bits, each 64 bits word has its own mask,
+* only the word involved is deobfuscated to test or modify a bit
+*/
+
+template <size_t N>
+class CvarObfuscatedBitset {
+public:
+    // Constructor, every bit is reset
+    CvarObfuscatedBitset() {
+        for (size_t i(0); i < s_szWordNbr; ++i) {
+            m_arrMsk[i] = SrandomMask::gen();
+            m_arrVal[i] = m_arrMsk[i];
+        }
+    }
+
+    CvarObfuscatedBitset(const CvarObfuscatedBitset &) = delete;
+    CvarObfuscatedBitset &operator=(const CvarObfuscatedBitset &) = delete;
+
+    // Number of bits
+    constexpr size_t size() const {
+        return N;
+    }
+
+    // Test a bit
+    bool test(const size_t _szPos) {
+        _checkPos(_szPos);
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        return ((_getWord(_szPos / 64) >> (_szPos % 64)) & 1) != 0;
+    }
+
+    // Set a bit to the given value
+    void set(const size_t _szPos, const bool _bVal = true) {
+        _checkPos(_szPos);
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        uint64_t ui64Bit(uint64_t(1) << (_szPos % 64)),
+                 ui64Word(_getWord(_szPos / 64));
+        _setWord(_szPos / 64, (_bVal ? (ui64Word | ui64Bit) : (ui64Word & ~ui64Bit)));
+    }
+
+    // Reset a bit
+    void reset(const size_t _szPos) {
+        set(_szPos, false);
+    }
+
+    // Number of bits set
+    size_t count() {
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        // Branchless loop over the whole set, left to the compiler to vectorize
+        size_t szCount(0);
+        for (size_t i(0); i < s_szWordNbr; ++i)
+            szCount += std::popcount(m_arrVal[i] ^ m_arrMsk[i]);
+        return szCount;
+    }
+
+    // If any bit is set
+    bool any() {
+        const std::lock_guard<std::mutex> lock(m_mtx);
+        uint64_t ui64Any(0);
+        for (size_t i(0); i < s_szWordNbr; ++i)
+            ui64Any |= m_arrVal[i] ^ m_arrMsk[i];
+        return ui64Any != 0;
+    }
+
+    // If no bit is set
+    bool none() {
+        return !any();
+    }
+
+private:
+    // Throws an error if the position is out of the set
+    void _checkPos(const size_t _szPos) const {
+        if (_szPos >= N)
+            throw std::out_of_range("CvarObfuscatedBitset position out of range.");
+    }
+
+    // Deobfuscate a single word
+    uint64_t _getWord(const size_t _szIndex) const {
+        return m_arrVal[_szIndex] ^ m_arrMsk[_szIndex];
+    }
+
+    // Obfuscate a single word with a new mask
+    void _setWord(const size_t _szIndex, const uint64_t _ui64Word) {
+        m_arrMsk[_szIndex] = SrandomMask::gen();
+        m_arrVal[_szIndex] = _ui64Word ^ m_arrMsk[_szIndex];
+    }
+
+    static constexpr size_t s_szWordNbr = (N + 63) / 64;
+
+    std::mutex                          m_mtx;
+    std::array<uint64_t, s_szWordNbr>   m_arrVal {},  // Stored masked words
+                                        m_arrMsk {};  // Stored masks
+};
+
+
+/*
+** CvarObfuscatedMappedBlob
+* Large read-only table stored obfuscated on disk, memory mapped and deobfuscated by pages on demand
+* Every page is XORed with its own key derived from the blob key, a few deobfuscated pages are kept in a LRU cache
+*
+*     +-------+---------+------+--------+--------+-----+
+*     | MAGIC | VERSION | SIZE | PAGE 0 | PAGE 1 | ... |
+*     +-------+---------+------+--------+--------+-----+
+*       4       4         8      4096     4096
+*/
+
+class CvarObfuscatedMappedBlob {
+public:
+    static constexpr size_t s_szPageSize = 4096;
+
+    // Obfuscate a plain file into a blob file
+    static void encodeFile(const std::string &_strSrcPath, const std::string &_strDstPath, const uint64_t _ui64Key) {
+        std::ifstream ifs(_strSrcPath, std::ios::binary);
+        std::ofstream ofs(_strDstPath, std::ios::binary | std::ios::trunc);
+        if (!ifs || !ofs)
+            throw std::runtime_error("Unable to open the blob files.");
+
+        // Header, the size is written once known
+        uint64_t ui64Size(0);
+        ofs.write(reinterpret_cast<const char *>(&s_ui32FileMagic), sizeof(uint32_t));
+        ofs.write(reinterpret_cast<const char *>(&s_ui32FileVersion), sizeof(uint32_t));
+        ofs.write(reinterpret_cast<const char *>(&ui64Size), sizeof(uint64_t));
+
+        // Obfuscate page by page
+        uint8_t ui8Page[s_szPageSize];
+        for (uint64_t ui64Page(0); ifs; ++ui64Page) {
+            ifs.read(reinterpret_cast<char *>(ui8Page), s_szPageSize);
+            size_t szRead(static_cast<size_t>(ifs.gcount()));
+            if (szRead == 0)
+                break;
+
+            _xorPage(ui8Page, ui8Page, szRead, _ui64Key, ui64Page);
+            ofs.write(reinterpret_cast<const char *>(ui8Page), szRead);
+            ui64Size += szRead;
+        }
+
+        ofs.seekp(sizeof(uint32_t) * 2);
+        ofs.write(reinterpret_cast<const char *>(&ui64Size), sizeof(uint64_t));
+        ofs.close();
+        if (!ofs)
+            throw std::runtime_error("Unable to write the blob file.");
+    }
+
+    // Constructor, map the blob file
+    CvarObfuscatedMappedBlob(const std::string &_strPath, const uint64_t _ui64Key, const size_t _szCachePageNbr = 16)
+        : m_owKey(_ui64Key),
+          m_vecCache(_szCachePageNbr < 1 ? 1 : _szCachePageNbr) {
+        _map(_strPath);
+
+        uint32_t ui32Magic, ui32Version;
+        ::memcpy(&ui32Magic, m_ptrMap, sizeof(uint32_t));
+        ::memcpy(&ui32Version, m_ptrMap + sizeof(uint32_t), sizeof(uint32_t));
+        ::memcpy(&m_ui64Size, m_ptrMap + sizeof(uint32_t) * 2, sizeof(uint64_t));
+        if (ui32Magic != s_ui32FileMagic || ui32Version != s_ui32FileVersion || m_ui64Size > m_szMapSize - s_szHeaderSize) {
+            _unmap();
+            throw std::runtime_error("Invalid blob file.");
+        }
+    }
+
+    CvarObfuscatedMappedBlob(const CvarObfuscatedMappedBlob &) = delete;
+    CvarObfuscatedMappedBlob &operator=(const CvarObfuscatedMappedBlob &) = delete;
+
+    // Destructor
+    ~CvarObfuscatedMappedBlob() {
+        // Wipe the deobfuscated pages
+        for (Spage &page : m_vecCache) {
+            volatile uint8_t *ptrData(page.m_ui8Data);
+            for (size_t i(0); i < s_szPageSize; ++i)
+                ptrData[i] = 0;
+        }
+        _unmap();
+    }
+
+    // Size in bytes of the deobfuscated blob
+    uint64_t size() const {
+        return m_ui64Size;
+    }
+
+    // Copy a range of the deobfuscated blob
+    void read(const uint64_t _ui64Offset, void *_ptrDst, const size_t _szLen) {
+        if (_ui64Offset > m_ui64Size || _szLen > m_ui64Size - _ui64Offset)
+            throw std::out_of_range("CvarObfuscatedMappedBlob range out of bounds.");
+
+        const std::lock_guard<std::mutex> lock(m_mtx);
+
+        uint8_t *ptrDst(static_cast<uint8_t *>(_ptrDst));
+        uint64_t ui64Pos(_ui64Offset);
+        size_t   szLeft(_szLen);
+        while (szLeft > 0) {
+            uint64_t ui64Page(ui64Pos / s_szPageSize);
+            size_t   szInPage(static_cast<size_t>(ui64Pos % s_szPageSize)),
+                     szCopy(std::min(szLeft, s_szPageSize - szInPage));
+
+            ::memcpy(ptrDst, _getPage(ui64Page)->m_ui8Data + szInPage, szCopy);
+
+            ptrDst  += szCopy;
+            ui64Pos += szCopy;
+            szLeft  -= szCopy;
+        }
+    }
+
+private:
+    // Deobfuscated page of the cache
+    struct Spage {
+        uint64_t m_ui64Page = UINT64_MAX;
+        uint64_t m_ui64Tick = 0;
+        uint8_t  m_ui8Data[s_szPageSize];
+    };
+
+    // Retrieve a deobfuscated page, from the cache or by replacing the least recently used one
+    Spage *_getPage(const uint64_t _ui64Page) {
+        ++m_ui64Tick;
+
+        Spage *ptrLru(&m_vecCache[0]);
+        for (Spage &page : m_vecCache) {
+            if (page.m_ui64Page == _ui64Page) {
+                page.m_ui64Tick = m_ui64Tick;
+                return &page;
+            }
+            if (page.m_ui64Tick < ptrLru->m_ui64Tick)
+                ptrLru = &page;
+        }
+
+        // Deobfuscate the page from the mapped file
+        uint64_t ui64Beg(_ui64Page * s_szPageSize);
+        size_t   szLen(static_cast<size_t>(std::min<uint64_t>(s_szPageSize, m_ui64Size - ui64Beg)));
+        _xorPage(m_ptrMap + s_szHeaderSize + ui64Beg, ptrLru->m_ui8Data, szLen, m_owKey.load(), _ui64Page);
+
+        ptrLru->m_ui64Page = _ui64Page;
+        ptrLru->m_ui64Tick = m_ui64Tick;
+        return ptrLru;
+    }
+
+    // XOR a page with its own key, a sequence of 64 bytes derived from the blob key and the page index
+    static void _xorPage(const uint8_t *_ptrSrc, uint8_t *_ptrDst, const size_t _szLen, const uint64_t _ui64Key, const uint64_t _ui64Page) {
+        uint64_t ui64PageSeed(ScompileTimeKey::mix(_ui64Key ^ ScompileTimeKey::mix(_ui64Page))),
+                 ui64PageKey[8];
+        for (int i(0); i < 8; ++i)
+            ui64PageKey[i] = ScompileTimeKey::keyWord(ui64PageSeed, i);
+
+        size_t i(0);
+        for (; i + 8 <= _szLen; i += 8) {
+            uint64_t ui64Word;
+            ::memcpy(&ui64Word, _ptrSrc + i, 8);
+            ui64Word ^= ui64PageKey[(i / 8) % 8];
+            ::memcpy(_ptrDst + i, &ui64Word, 8);
+        }
+        for (; i < _szLen; ++i)
+            _ptrDst[i] = _ptrSrc[i] ^ static_cast<uint8_t>(ui64PageKey[(i / 8) % 8] >> ((i % 8) * 8));
+    }
+
+    // Map the whole file in memory, read only
+    void _map(const std::string &_strPath) {
+#if defined(_WIN32)
+        m_hFile = ::CreateFileA(_strPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (m_hFile == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Unable to open the blob file.");
+
+        LARGE_INTEGER liSize;
+        if (!::GetFileSizeEx(m_hFile, &liSize) || static_cast<size_t>(liSize.QuadPart) < s_szHeaderSize) {
+            ::CloseHandle(m_hFile);
+            throw std::runtime_error("Invalid blob file.");
+        }
+        m_szMapSize = static_cast<size_t>(liSize.QuadPart);
+
+        m_hMapping = ::CreateFileMappingA(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+        m_ptrMap = (m_hMapping ? static_cast<const uint8_t *>(::MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0)) : nullptr);
+        if (m_ptrMap == nullptr) {
+            if (m_hMapping) ::CloseHandle(m_hMapping);
+            ::CloseHandle(m_hFile);
+            throw std::runtime_error("Unable to map the blob file.");
+        }
+#else
+        int iFd(::open(_strPath.c_str(), O_RDONLY));
+        if (iFd < 0)
+            throw std::runtime_error("Unable to open the blob file.");
+
+        struct stat stFile;
+        if (::fstat(iFd, &stFile) != 0 || static_cast<size_t>(stFile.st_size) < s_szHeaderSize) {
+            ::close(iFd);
+            throw std::runtime_error("Invalid blob file.");
+        }
+        m_szMapSize = static_cast<size_t>(stFile.st_size);
+
+        void *ptrMap(::mmap(nullptr, m_szMapSize, PROT_READ, MAP_PRIVATE, iFd, 0));
+        // The mapping stays valid once the file descriptor is closed
+        ::close(iFd);
+        if (ptrMap == MAP_FAILED)
+            throw std::runtime_error("Unable to map the blob file.");
+        m_ptrMap = static_cast<const uint8_t *>(ptrMap);
+#endif
+    }
+
+    // Release the mapping
+    void _unmap() {
+        if (m_ptrMap == nullptr)
+            return;
+#if defined(_WIN32)
+        ::UnmapViewOfFile(m_ptrMap);
+        ::CloseHandle(m_hMapping);
+        ::CloseHandle(m_hFile);
+#else
+        ::munmap(const_cast<uint8_t *>(m_ptrMap), m_szMapSize);
+#endif
+        m_ptrMap = nullptr;
+    }
+
+    static constexpr uint32_t s_ui32FileMagic   = 0x424D534D; // "MSMB"
+    static constexpr uint32_t s_ui32FileVersion = 1;
+    static constexpr size_t   s_szHeaderSize    = sizeof(uint32_t) * 2 + sizeof(uint64_t);
+
+    std::mutex                      m_mtx;
+    CvarObfuscatedWord<uint64_t>    m_owKey;
+    uint64_t                        m_ui64Size  = 0,
+                                    m_ui64Tick  = 0;
+    std::vector<Spage>              m_vecCache;
+    const uint8_t                  *m_ptrMap    = nullptr;
+    size_t                          m_szMapSize = 0;
+#if defined(_WIN32)
+    HANDLE                          m_hFile     = INVALID_HANDLE_VALUE,
+                                    m_hMapping  = NULL;
+#endif
+};
+
+/*
+** CvarObfuscatedShared
+* Obfuscate a value shared between processes, stored in a named shared memory segment (shm_open or CreateFileMapping)
+* The hops, the key and the value live in a single arena of the segment, linked with offsets instead of pointers,
+* so every process follows the same chains wherever the segment is mapped
+* Readers and writers are synchronized with a sequence lock, a writer terminated while holding it is replaced by the next one,
+* as is a process terminated while initializing the segment
+*
+*     +--------+----------------+-------------+---------------+
+*     | HEADER | HOPS (32 words)| KEY (N + 8) | VALUE (N + 8) |
+*     +--------+----------------+-------------+---------------+
+*/
+
+template <typename T>
+class CvarObfuscatedShared {
+    static_assert(std::is_trivially_copyable_v<T>, "CvarObfuscatedShared requires a trivially copyable type.");
+    static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free, "CvarObfuscatedShared requires lock free atomics.");
+
+public:
+    // Constructor, open the named segment, or create it with a default value
+    CvarObfuscatedShared(const std::string &_strName) {
+        _map(_strName);
+
+        // The first process claims and initializes the segment, the others wait for it,
+        // and take the initialization over if that process was terminated before the end
+        uint32_t ui32Pid(_pid());
+        while (m_ptrSeg->m_ui32State.load(std::memory_order_acquire) != 2) {
+            uint32_t ui32Owner(m_ptrSeg->m_ui32InitOwner.load(std::memory_order_acquire));
+            if ((ui32Owner == 0 || (ui32Owner != ui32Pid && !_isAlive(ui32Owner)))
+                && m_ptrSeg->m_ui32InitOwner.compare_exchange_strong(ui32Owner, ui32Pid, std::memory_order_acq_rel)) {
+                // The segment may have been completed just before its initializer was terminated
+                if (m_ptrSeg->m_ui32State.load(std::memory_order_acquire) != 2)
+                    _init();
+                break;
+            }
+            std::this_thread::yield();
+        }
+
+        if (m_ptrSeg->m_ui32Magic != s_ui32Magic || m_ptrSeg->m_ui32TypeSize != sizeof(T)) {
+            _unmap();
+            throw std::runtime_error("The shared segment does not hold a value of this type.");
+        }
+    }
+
+    CvarObfuscatedShared(const CvarObfuscatedShared &) = delete;
+    CvarObfuscatedShared &operator=(const CvarObfuscatedShared &) = delete;
+
+    // Destructor, the segment stays available to the other processes
+    ~CvarObfuscatedShared() {
+        _unmap();
+    }
+
+    // Remove the named segment, the processes which mapped it keep their mapping
+    static void unlink(const std::string &_strName) {
+#if !defined(_WIN32)
+        ::shm_unlink(("/" + _strName).c_str());
+#endif
+    }
+
+    // Getter
+    operator T() const {
+        return _read();
+    }
+
+
+    /*
+    ** Assignment Operators
+    */
+
+    // = Assignation
+    T operator=(const T &_val) {
+        _modify([&](const T &) { return _val; });
+        return _val;
+    }
+
+
+    /*
+    ** Atomic Operations
+    */
+
+    // Retrieve the value
+    T load() const {
+        return _read();
+    }
+
+    // Replace the value
+    void store(const T &_val) {
+        _modify([&](const T &) { return _val; });
+    }
+
+    // Replace the value, and return the previous one
+    T exchange(const T &_val) {
+        return _modify([&](const T &) { return _val; });
+    }
+
+    // Replace the value with the desired one if it is equal to the expected one,
+    // otherwise the expected one is updated with the actual value
+    bool compare_exchange_strong(T &_expected, const T &_desired) {
+        bool bExchanged(false);
+        T val(_modify([&](const T &_old) {
+            bExchanged = (::memcmp(&_old, &_expected, sizeof(T)) == 0);
+            return (bExchanged ? _desired : _old);
+        }));
+        if (!bExchanged)
+            _expected = val;
+        return bExchanged;
+    }
+
+    // Add to the value, and return the previous one
+    T fetch_add(const T &_val) {
+        return _modify([&](const T &_old) { return static_cast<T>(_old + _val); });
+    }
+
+    // Subtract from the value, and return the previous one
+    T fetch_sub(const T &_val) {
+        return _modify([&](const T &_old) { return static_cast<T>(_old - _val); });
+    }
+
+
+    /*
+    ** Arithmetic Compound Assignment Operators
+    */
+
+    // += Addition
+    T operator+=(const T &_val) {
+        return static_cast<T>(fetch_add(_val) + _val);
+    }
+
+    // -= Subtraction
+    T operator-=(const T &_val) {
+        return static_cast<T>(fetch_sub(_val) - _val);
+    }
+
+
+    /*
+    ** Relational Operators
+    */
+
+    // == Is equal to
+    bool operator==(const T &_vr) const {
+        T val(_read());
+        return (::memcmp(&val, &_vr, sizeof(T)) == 0);
+    }
+
+    // != Not equal to
+    bool operator!=(const T &_vr) const {
+        return !(*this == _vr);
+    }
+
+private:
+    static constexpr uint32_t s_ui32Magic      = 0x534D534D; // "MSMS"
+    static constexpr size_t   s_szWordNbr      = (sizeof(T) + 7) / 8;
+    static constexpr size_t   s_szHopWords     = 32;
+    static constexpr size_t   s_szRegionWords  = s_szWordNbr + 8;
+    static constexpr size_t   s_szArenaWords   = s_szHopWords + s_szRegionWords * 2;
+
+    // Content of the shared memory segment, zero filled when created
+    struct Ssegment {
+        std::atomic<uint32_t>   m_ui32State,        // 0 created, 1 initializing, 2 ready
+                                m_ui32InitOwner;    // Process initializing the segment
+        uint32_t                m_ui32Magic,
+                                m_ui32TypeSize;
+        std::atomic<uint32_t>   m_ui32Seq,          // Sequence lock
+                                m_ui32Owner;        // Process holding the writer side
+        std::atomic<uint64_t>   m_ui64Specs,        // Masked hop heads and hop numbers
+                                m_ui64SpecsMsk;
+        std::atomic<uint64_t>   m_ui64Arena[s_szArenaWords];
+    };
+
+    // Write the header and a default value, nothing reads nor writes the segment before it is ready,
+    // so a lock left by a terminated initializer is cleared instead of taken over
+    void _init() {
+        m_ptrSeg->m_ui32State.store(1, std::memory_order_relaxed);
+        m_ptrSeg->m_ui32Magic    = s_ui32Magic;
+        m_ptrSeg->m_ui32TypeSize = sizeof(T);
+        m_ptrSeg->m_ui32Owner.store(0, std::memory_order_relaxed);
+        m_ptrSeg->m_ui32Seq.store(m_ptrSeg->m_ui32Seq.load(std::memory_order_relaxed) & ~1u, std::memory_order_relaxed);
+        _encode(T());
+        m_ptrSeg->m_ui32State.store(2, std::memory_order_release);
+    }
+
+
+    /*
+    ** Sequence lock
+    */
+
+    // Acquire the writer side of the sequence lock (odd sequence number),
+    // the value is reset if the previous writer was terminated while holding it
+    uint32_t _lock() {
+        uint32_t ui32Pid(_pid());
+        while (true) {
+            uint32_t ui32Seq(m_ptrSeg->m_ui32Seq.load(std::memory_order_relaxed));
+            if ((ui32Seq & 1) == 0) {
+                if (m_ptrSeg->m_ui32Seq.compare_exchange_weak(ui32Seq, ui32Seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    m_ptrSeg->m_ui32Owner.store(ui32Pid, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_release);
+                    return ui32Seq + 1;
+                }
+                continue;
+            }
+
+            // Take over the lock of a terminated process, its value may be half written
+            uint32_t ui32Owner(m_ptrSeg->m_ui32Owner.load(std::memory_order_relaxed));
+            if (ui32Owner != 0 && ui32Owner != ui32Pid && !_isAlive(ui32Owner)
+                && m_ptrSeg->m_ui32Owner.compare_exchange_strong(ui32Owner, ui32Pid, std::memory_order_acq_rel)) {
+                _encode(T());
+                return ui32Seq;
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+    // Release the writer side of the sequence lock (even sequence number)
+    void _unlock(const uint32_t _ui32Seq) {
+        m_ptrSeg->m_ui32Owner.store(0, std::memory_order_relaxed);
+        m_ptrSeg->m_ui32Seq.store(_ui32Seq + 1, std::memory_order_release);
+    }
+
+    // Read a consistent value
+    T _read() const {
+        uint64_t ui64Val[s_szWordNbr];
+        T val;
+        while (true) {
+            uint32_t ui32Seq(m_ptrSeg->m_ui32Seq.load(std::memory_order_acquire));
+            // A writer is in progress
+            if (ui32Seq & 1) {
+                uint32_t ui32Owner(m_ptrSeg->m_ui32Owner.load(std::memory_order_relaxed));
+                if (ui32Owner != 0 && ui32Owner != _pid() && !_isAlive(ui32Owner))
+                    throw std::runtime_error("The shared value was left half written by a terminated process.");
+                std::this_thread::yield();
+                continue;
+            }
+
+            bool bValid(_decode(ui64Val));
+
+            // Retry if a writer has modified the arena meanwhile
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_ptrSeg->m_ui32Seq.load(std::memory_order_relaxed) != ui32Seq)
+                continue;
+            // The chains are broken without any writer
+            if (!bValid)
+                throw std::runtime_error("The shared value is corrupted.");
+
+            ::memcpy(&val, ui64Val, sizeof(T));
+            _wipe(ui64Val);
+            return val;
+        }
+    }
+
+    // Replace the value by the result of the given function, and return the previous one
+    template <typename F>
+    T _modify(F _fnUpdate) {
+        uint32_t ui32Seq(_lock());
+
+        uint64_t ui64Val[s_szWordNbr];
+        T val;
+        if (!_decode(ui64Val)) {
+            _unlock(ui32Seq);
+            throw std::runtime_error("The shared value is corrupted.");
+        }
+        ::memcpy(&val, ui64Val, sizeof(T));
+        _wipe(ui64Val);
+
+        _encode(_fnUpdate(val));
+
+        _unlock(ui32Seq);
+        return val;
+    }
+
+
+    /*
+    ** Core
+    */
+
+    // Follow the hop chains and deobfuscate the value, false if a chain leaves the arena
+    bool _decode(uint64_t *_ui64Val) const {
+        uint64_t ui64Specs(m_ptrSeg->m_ui64Specs.load(std::memory_order_relaxed) ^ m_ptrSeg->m_ui64SpecsMsk.load(std::memory_order_relaxed));
+        size_t szValPos, szKeyPos;
+        if (!_unfold(static_cast<uint8_t>(ui64Specs), static_cast<uint8_t>(ui64Specs >> 16), &szValPos)
+            || !_unfold(static_cast<uint8_t>(ui64Specs >> 8), static_cast<uint8_t>(ui64Specs >> 24), &szKeyPos))
+            return false;
+
+        for (size_t i(0); i < s_szWordNbr; ++i)
+            _ui64Val[i] = m_ptrSeg->m_ui64Arena[szValPos + i].load(std::memory_order_relaxed)
+                        ^ m_ptrSeg->m_ui64Arena[szKeyPos + i].load(std::memory_order_relaxed);
+        return true;
+    }
+
+    // Obfuscate the value with a new key, at new positions of the arena, reached through new hop chains
+    void _encode(const T &_val) {
+        uint64_t ui64Val[s_szWordNbr] {};
+        ::memcpy(ui64Val, &_val, sizeof(T));
+
+        // Populate the whole arena with random noise data
+        for (size_t i(0); i < s_szArenaWords; ++i)
+            m_ptrSeg->m_ui64Arena[i].store(SrandomMask::gen(), std::memory_order_relaxed);
+
+        // Random positions of the key and the value in their regions
+        size_t szKeyPos(s_szHopWords + SrandomMask::gen() % 9),
+               szValPos(s_szHopWords + s_szRegionWords + SrandomMask::gen() % 9);
+        for (size_t i(0); i < s_szWordNbr; ++i) {
+            uint64_t ui64Key(SrandomMask::gen());
+            m_ptrSeg->m_ui64Arena[szKeyPos + i].store(ui64Key, std::memory_order_relaxed);
+            m_ptrSeg->m_ui64Arena[szValPos + i].store(ui64Val[i] ^ ui64Key, std::memory_order_relaxed);
+        }
+        _wipe(ui64Val);
+
+        // Pick distinct hop nodes for both chains (partial Fisher-Yates shuffle)
+        uint8_t ui8Slots[s_szHopWords];
+        for (size_t i(0); i < s_szHopWords; ++i)
+            ui8Slots[i] = static_cast<uint8_t>(i);
+        for (size_t i(0); i < 14; ++i)
+            std::swap(ui8Slots[i], ui8Slots[i + SrandomMask::gen() % (s_szHopWords - i)]);
+
+        uint8_t ui8ValHopNbr(SrandomMask::gen() % 7 + 1),
+                ui8KeyHopNbr(SrandomMask::gen() % 7 + 1);
+        _fold(ui8Slots, ui8ValHopNbr, szValPos);
+        _fold(ui8Slots + ui8ValHopNbr, ui8KeyHopNbr, szKeyPos);
+
+        // Store the masked specifications
+        uint64_t ui64Specs(static_cast<uint64_t>(ui8Slots[0])
+                           | (static_cast<uint64_t>(ui8Slots[ui8ValHopNbr]) << 8)
+                           | (static_cast<uint64_t>(ui8ValHopNbr) << 16)
+                           | (static_cast<uint64_t>(ui8KeyHopNbr) << 24)),
+                 ui64Msk(SrandomMask::gen());
+        m_ptrSeg->m_ui64Specs.store(ui64Specs ^ ui64Msk, std::memory_order_relaxed);
+        m_ptrSeg->m_ui64SpecsMsk.store(ui64Msk, std::memory_order_relaxed);
+    }
+
+    // Create a chain of hops, each node stores the offset to the next one, the last one the offset to the payload
+    void _fold(const uint8_t *_ui8Slots, const uint8_t _ui8HopNbr, const size_t _szTarget) {
+        for (uint8_t i(0); i < _ui8HopNbr; ++i) {
+            size_t szNext(i + 1 < _ui8HopNbr ? _ui8Slots[i + 1] : _szTarget);
+            m_ptrSeg->m_ui64Arena[_ui8Slots[i]].store(static_cast<uint64_t>(szNext) - _ui8Slots[i], std::memory_order_relaxed);
+        }
+    }
+
+    // Follow a chain of hops from its head, false if it leaves the arena
+    bool _unfold(const uint8_t _ui8Head, const uint8_t _ui8HopNbr, size_t *_szPos) const {
+        if (_ui8HopNbr < 1 || _ui8HopNbr > 7)
+            return false;
+
+        uint64_t ui64Pos(_ui8Head);
+        for (uint8_t i(0); i < _ui8HopNbr; ++i) {
+            if (ui64Pos >= s_szArenaWords)
+                return false;
+            ui64Pos += m_ptrSeg->m_ui64Arena[ui64Pos].load(std::memory_order_relaxed);
+        }
+
+        // The payload must fit in the arena
+        if (ui64Pos < s_szHopWords || ui64Pos > s_szArenaWords - s_szWordNbr)
+            return false;
+        *_szPos = static_cast<size_t>(ui64Pos);
+        return true;
+    }
+
+    // Wipe a plain value through a volatile pointer, the compiler can not discard the writes
+    static void _wipe(uint64_t *_ui64Val) {
+        volatile uint64_t *ptrVal(_ui64Val);
+        for (size_t i(0); i < s_szWordNbr; ++i)
+            ptrVal[i] = 0;
+    }
+
+    // Identifier of the current process
+    static uint32_t _pid() {
+#if defined(_WIN32)
+        return static_cast<uint32_t>(::GetCurrentProcessId());
+#else
+        return static_cast<uint32_t>(::getpid());
+#endif
+    }
+
+    // If a process is still running
+    static bool _isAlive(const uint32_t _ui32Pid) {
+#if defined(_WIN32)
+        HANDLE hProcess(::OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(_ui32Pid)));
+        if (hProcess == NULL)
+            return (::GetLastError() == ERROR_ACCESS_DENIED);
+        bool bAlive(::WaitForSingleObject(hProcess, 0) == WAIT_TIMEOUT);
+        ::CloseHandle(hProcess);
+        return bAlive;
+#else
+        return (::kill(static_cast<pid_t>(_ui32Pid), 0) == 0 || errno == EPERM);
+#endif
+    }
+
+    // Map the named segment in memory, created zero filled if it does not exist yet
+    void _map(const std::string &_strName) {
+#if defined(_WIN32)
+        m_hMapping = ::CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, static_cast<DWORD>(sizeof(Ssegment)), ("Local\\" + _strName).c_str());
+        void *ptrMap(m_hMapping ? ::MapViewOfFile(m_hMapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(Ssegment)) : nullptr);
+        if (ptrMap == nullptr) {
+            if (m_hMapping) ::CloseHandle(m_hMapping);
+            throw std::runtime_error("Unable to map the shared segment.");
+        }
+#else
+        int iFd(::shm_open(("/" + _strName).c_str(), O_RDWR | O_CREAT, 0600));
+        if (iFd < 0)
+            throw std::runtime_error("Unable to open the shared segment.");
+
+        // Every process sets the same size, the segment is only extended once
+        struct stat stSeg;
+        if (::fstat(iFd, &stSeg) != 0
+            || (static_cast<size_t>(stSeg.st_size) < sizeof(Ssegment) && ::ftruncate(iFd, sizeof(Ssegment)) != 0)) {
+            ::close(iFd);
+            throw std::runtime_error("Unable to size the shared segment.");
+        }
+
+        void *ptrMap(::mmap(nullptr, sizeof(Ssegment), PROT_READ | PROT_WRITE, MAP_SHARED, iFd, 0));
+        // The mapping stays valid once the file descriptor is closed
+        ::close(iFd);
+        if (ptrMap == MAP_FAILED)
+            throw std::runtime_error("Unable to map the shared segment.");
+#endif
+        m_ptrSeg = static_cast<Ssegment *>(ptrMap);
+    }
+
+    // Release the mapping
+    void _unmap() {
+        if (m_ptrSeg == nullptr)
+            return;
+#if defined(_WIN32)
+        ::UnmapViewOfFile(m_ptrSeg);
+        ::CloseHandle(m_hMapping);
+#else
+        ::munmap(m_ptrSeg, sizeof(Ssegment));
+#endif
+        m_ptrSeg = nullptr;
+    }
+
+    Ssegment   *m_ptrSeg    = nullptr;
+#if defined(_WIN32)
+    HANDLE      m_hMapping  = NULL;
+#endif
+};
\ No newline at end of file
@@ -0,0 +1,308 @@
+#include "CvarObfuscated.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+
+/*
+** Payloads
+*
+*/
+
+// JSON like configuration text, compressible as real configurations are
+static std::string genConfig(const size_t _szSize) {
+    std::string strRet;
+    for (int i(0); strRet.size() < _szSize; ++i)
+        strRet += "{\"id\":" + std::to_string(i) + ",\"name\":\"entity_" + std::to_string(i % 37) + "\",\"speed\":" + std::to_string((i * 7) % 100) + ",\"enabled\":true},";
+    strRet.resize(_szSize);
+    return strRet;
+}
+
+
+
+/*
+** Compression
+* Read and write throughput of large text values, stored as is or compressed
+*/
+
+static void BM_stringGet(benchmark::State &_state, const bool _bCompression) {
+    CvarObfuscated<std::string> ovVariable;
+    ovVariable.set_compression(_bCompression);
+    std::string strPlain(genConfig(static_cast<size_t>(_state.range(0))));
+    ovVariable = strPlain;
+
+    for (auto _ : _state) {
+        std::string strRet(ovVariable);
+        benchmark::DoNotOptimize(strRet.data());
+    }
+    _state.SetBytesProcessed(_state.iterations() * _state.range(0));
+
+    // Stored payload size against the plain size
+    std::vector<uint8_t> vecComp(strPlain.size());
+    int iCompSize(Scompressor::compress(reinterpret_cast<const uint8_t *>(strPlain.data()), static_cast<int>(strPlain.size()), vecComp.data(), static_cast<int>(vecComp.size())));
+    _state.counters["stored_ratio"] = (_bCompression && iCompSize > 0) ? static_cast<double>(iCompSize + sizeof(uint32_t)) / strPlain.size() : 1.0;
+}
+BENCHMARK_CAPTURE(BM_stringGet, plain, false)->Name("strRet = ovString;")->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_CAPTURE(BM_stringGet, compressed, true)->Name("strRet = ovString; (compressed)")->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+static void BM_stringSet(benchmark::State &_state, const bool _bCompression) {
+    CvarObfuscated<std::string> ovVariable;
+    ovVariable.set_compression(_bCompression);
+    std::string strPlain(genConfig(static_cast<size_t>(_state.range(0))));
+
+    for (auto _ : _state)
+        ovVariable = strPlain;
+    _state.SetBytesProcessed(_state.iterations() * _state.range(0));
+}
+BENCHMARK_CAPTURE(BM_stringSet, plain, false)->Name("ovString = strPlain;")->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_CAPTURE(BM_stringSet, compressed, true)->Name("ovString = strPlain; (compressed)")->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+
+
+/*
+** Integrity
+* Read latency of values up to 1 KB, with and without the checksum verification
+*/
+
+static void BM_integrityGet(benchmark::State &_state, const bool _bIntegrity) {
+    CvarObfuscated<std::vector<uint8_t>> ovVariable;
+    ovVariable.set_integrity(_bIntegrity);
+    ovVariable = std::vector<uint8_t>(static_cast<size_t>(_state.range(0)), 0x5A);
+
+    for (auto _ : _state) {
+        std::vector<uint8_t> vecRet(ovVariable);
+        benchmark::DoNotOptimize(vecRet.data());
+    }
+}
+BENCHMARK_CAPTURE(BM_integrityGet, unchecked, false)->Name("vecRet = ovVector;")->RangeMultiplier(4)->Range(4, 1 << 10);
+BENCHMARK_CAPTURE(BM_integrityGet, checked, true)->Name("vecRet = ovVector; (integrity)")->RangeMultiplier(4)->Range(4, 1 << 10);
+
+// Checksum alone, the overhead added to each read
+static void BM_integrityHash(benchmark::State &_state) {
+    std::vector<uint8_t> vecBuff(static_cast<size_t>(_state.range(0)), 0x5A);
+    for (auto _ : _state)
+        benchmark::DoNotOptimize(Sintegrity::hash(vecBuff.data(), static_cast<int>(vecBuff.size()), 0x1234));
+    _state.SetBytesProcessed(_state.iterations() * _state.range(0));
+}
+BENCHMARK(BM_integrityHash)->Name("Sintegrity::hash()")->RangeMultiplier(4)->Range(4, 1 << 10);
+
+
+
+/*
+** Redundancy
+* Read latency with a single copy, and with a shadow copy decoded and compared on every read
+*/
+
+static void BM_redundancyGet(benchmark::State &_state, const bool _bRedundancy) {
+    CvarObfuscated<std::vector<uint8_t>> ovVariable;
+    ovVariable.set_redundancy(_bRedundancy);
+    ovVariable = std::vector<uint8_t>(static_cast<size_t>(_state.range(0)), 0x5A);
+
+    for (auto _ : _state) {
+        std::vector<uint8_t> vecRet(ovVariable);
+        benchmark::DoNotOptimize(vecRet.data());
+    }
+}
+BENCHMARK_CAPTURE(BM_redundancyGet, single, false)->Name("vecRet = ovVector; (single copy)")->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK_CAPTURE(BM_redundancyGet, redundant, true)->Name("vecRet = ovVector; (redundant)")->RangeMultiplier(8)->Range(8, 1 << 12);
+
+
+
+/*
+** Adaptive hops
+* Read latency of a hot instance, with random chains and with chains matching its heat
+*/
+
+static void BM_adaptiveGet(benchmark::State &_state, const bool _bAdaptive) {
+    CvarObfuscated<int64_t> ovVariable;
+    ovVariable.set_adaptive_hops(_bAdaptive);
+    ovVariable = 0x5A5A;
+
+    for (auto _ : _state) {
+        int64_t i64Ret(ovVariable);
+        benchmark::DoNotOptimize(i64Ret);
+    }
+    _state.counters["hop_bytes"] = static_cast<double>(ovVariable.memory_usage().m_szHops);
+}
+BENCHMARK_CAPTURE(BM_adaptiveGet, random, false)->Name("i64Ret = ovInt64; (random hops)");
+BENCHMARK_CAPTURE(BM_adaptiveGet, adaptive, true)->Name("i64Ret = ovInt64; (adaptive hops)");
+
+
+
+/*
+** Thread scaling
+* Throughput and p99 latency of get heavy, set heavy and mixed workloads from 1 to N threads,
+* on a single instance shared by every thread, and on an instance per thread
+*/
+
+static const int s_iMaxThreads(static_cast<int>(std::max(1u, std::thread::hardware_concurrency())));
+static CvarObfuscated<int64_t> s_ovShared;
+
+static void BM_scaling(benchmark::State &_state, const int _iGetPercent, const bool _bShared) {
+    CvarObfuscated<int64_t> ovLocal;
+    CvarObfuscated<int64_t> &ovVariable(_bShared ? s_ovShared : ovLocal);
+
+    // Latencies of the last operations, the ring keeps the memory per thread bounded
+    constexpr size_t szRing(1 << 16);
+    std::vector<int64_t> vecLatencies(szRing);
+    uint64_t ui64Op(static_cast<uint64_t>(_state.thread_index()) * 13);
+
+    for (auto _ : _state) {
+        std::chrono::steady_clock::time_point tpBeg(std::chrono::steady_clock::now());
+        // 37 is coprime with 100, the gets and sets are interleaved instead of grouped
+        if (static_cast<int>((ui64Op * 37) % 100) < _iGetPercent) {
+            int64_t i64Ret(ovVariable);
+            benchmark::DoNotOptimize(i64Ret);
+        }
+        else
+            ovVariable += 1;
+        vecLatencies[ui64Op++ % szRing] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tpBeg).count();
+    }
+
+    vecLatencies.resize(std::min<size_t>(ui64Op - static_cast<uint64_t>(_state.thread_index()) * 13, szRing));
+    if (!vecLatencies.empty()) {
+        auto itP99(vecLatencies.begin() + vecLatencies.size() * 99 / 100);
+        std::nth_element(vecLatencies.begin(), itP99, vecLatencies.end());
+        _state.counters["p99_ns"] = benchmark::Counter(static_cast<double>(*itP99), benchmark::Counter::kAvgThreads);
+    }
+    _state.SetItemsProcessed(_state.iterations());
+}
+BENCHMARK_CAPTURE(BM_scaling, get_shared, 90, true)->Name("ovInt64 90% get; (shared)")->ThreadRange(1, s_iMaxThreads)->UseRealTime();
+BENCHMARK_CAPTURE(BM_scaling, get_local, 90, false)->Name("ovInt64 90% get; (per thread)")->ThreadRange(1, s_iMaxThreads)->UseRealTime();
+BENCHMARK_CAPTURE(BM_scaling, set_shared, 10, true)->Name("ovInt64 90% +=; (shared)")->ThreadRange(1, s_iMaxThreads)->UseRealTime();
+BENCHMARK_CAPTURE(BM_scaling, set_local, 10, false)->Name("ovInt64 90% +=; (per thread)")->ThreadRange(1, s_iMaxThreads)->UseRealTime();
+BENCHMARK_CAPTURE(BM_scaling, mixed_shared, 50, true)->Name("ovInt64 50% get 50% +=; (shared)")->ThreadRange(1, s_iMaxThreads)->UseRealTime();
+BENCHMARK_CAPTURE(BM_scaling, mixed_local, 50, false)->Name("ovInt64 50% get 50% +=; (per thread)")->ThreadRange(1, s_iMaxThreads)->UseRealTime();
+
+
+
+/*
+** Baselines
+* The basic operations of CvarObfuscated<T> side by side with a plain T, a std::atomic<T>, a T guarded by a std::mutex and a bare CvarMasked<T>,
+* each case but the plain one reports overhead_x, its time per operation relative to the plain T of the same operation and type
+* (--benchmark_out=baseline.json --benchmark_out_format=json keeps them machine readable, to be compared across releases)
+*/
+
+template <typename T>
+struct SbasePlain {
+    T get() { return m_val; }
+    void set(const T &_val) { m_val = _val; }
+    void add(const T &_val) { m_val += _val; }
+    T                       m_val = T();
+};
+
+template <typename T>
+struct SbaseAtomic {
+    T get() { return m_val.load(); }
+    void set(const T &_val) { m_val.store(_val); }
+    void add(const T &_val) { m_val.fetch_add(_val); }
+    std::atomic<T>          m_val = T();
+};
+
+template <typename T>
+struct SbaseMutex {
+    T get() { const std::lock_guard<std::mutex> lock(m_mtx); return m_val; }
+    void set(const T &_val) { const std::lock_guard<std::mutex> lock(m_mtx); m_val = _val; }
+    void add(const T &_val) { const std::lock_guard<std::mutex> lock(m_mtx); m_val += _val; }
+    std::mutex              m_mtx;
+    T                       m_val = T();
+};
+
+template <typename T>
+struct SbaseMasked {
+    SbaseMasked() { m_mv.set(T()); }
+    T get() { return m_mv.get(); }
+    void set(const T &_val) { m_mv.set(_val); }
+    void add(const T &_val) { m_mv.set(m_mv.get() + _val); }
+    CvarMasked<T>           m_mv;
+};
+
+template <typename T>
+struct SbaseObfuscated {
+    SbaseObfuscated() { m_ov = T(); }
+    T get() { return m_ov; }
+    void set(const T &_val) { m_ov = _val; }
+    void add(const T &_val) { m_ov += _val; }
+    CvarObfuscated<T>       m_ov;
+};
+
+enum class Eop { get, set, add };
+
+// Time per operation of the plain T, by operation and type, the plain cases are registered first
+static std::map<std::string, double> s_mapBaseline;
+
+template <typename H, typename T, Eop E>
+static void BM_baseline(benchmark::State &_state, const std::string &_strKey, const bool _bReference) {
+    H holder;
+    T val(1);
+    // The holder escapes, the plain T is loaded and stored for real instead of kept in a register
+    benchmark::DoNotOptimize(holder);
+
+    std::chrono::steady_clock::time_point tpBeg(std::chrono::steady_clock::now());
+    for (auto _ : _state) {
+        if constexpr (E == Eop::get) {
+            T ret(holder.get());
+            benchmark::DoNotOptimize(ret);
+        }
+        else if constexpr (E == Eop::set)
+            holder.set(val);
+        else
+            holder.add(val);
+        benchmark::ClobberMemory();
+    }
+    double dNs(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - tpBeg).count() / static_cast<double>(std::max<benchmark::IterationCount>(_state.iterations(), 1)));
+    _state.SetItemsProcessed(_state.iterations());
+
+    // Overhead multiplier against the plain T measured in the same run, if it was not filtered out
+    if (_bReference)
+        s_mapBaseline[_strKey] = dNs;
+    else if (auto it(s_mapBaseline.find(_strKey)); it != s_mapBaseline.end() && it->second > 0)
+        _state.counters["overhead_x"] = dNs / it->second;
+}
+
+template <typename T, Eop E>
+static void registerBaseline(const std::string &_strType, const std::string &_strOp) {
+    std::string strKey(_strType + " " + _strOp);
+    benchmark::RegisterBenchmark((strKey + " (plain)").c_str(), BM_baseline<SbasePlain<T>, T, E>, strKey, true);
+    benchmark::RegisterBenchmark((strKey + " (std::atomic)").c_str(), BM_baseline<SbaseAtomic<T>, T, E>, strKey, false);
+    benchmark::RegisterBenchmark((strKey + " (std::mutex)").c_str(), BM_baseline<SbaseMutex<T>, T, E>, strKey, false);
+    benchmark::RegisterBenchmark((strKey + " (CvarMasked)").c_str(), BM_baseline<SbaseMasked<T>, T, E>, strKey, false);
+    benchmark::RegisterBenchmark((strKey + " (CvarObfuscated)").c_str(), BM_baseline<SbaseObfuscated<T>, T, E>, strKey, false);
+}
+
+template <typename T>
+static int registerBaselines(const std::string &_strType) {
+    registerBaseline<T, Eop::get>(_strType, "get;");
+    registerBaseline<T, Eop::set>(_strType, "set;");
+    registerBaseline<T, Eop::add>(_strType, "+=;");
+    return 0;
+}
+static const int s_iBaselines(registerBaselines<int32_t>("int32_t") + registerBaselines<int64_t>("int64_t"));
+
+
+
+/*
+** Entry point
+*
+*/
+int main(int argc, char **argv) {
+    // Initialize the CvarObfuscated class
+    CvarObfuscated<void>::init(true);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "CvarObfuscated.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+
+
+/*
+** Interposed allocator
+* Every allocation is preceded by a header holding its size, so the live bytes are known at release
+*
+*     +--------+---------...---------+
+*     | SIZE   | USER BLOCK          |
+*     +--------+---------...---------+
+*       16
+*/
+
+static std::atomic<int64_t>  s_i64LiveBytes(0),
+                             s_i64Allocs(0);
+
+static constexpr size_t s_szHeader(16);    // Keeps the user block aligned as malloc()
+
+static void *countedAlloc(const size_t _szSize) {
+    uint8_t *ptrBlock(static_cast<uint8_t *>(std::malloc(_szSize + s_szHeader)));
+    if (ptrBlock == nullptr)
+        throw std::bad_alloc();
+    *reinterpret_cast<size_t *>(ptrBlock) = _szSize;
+    s_i64LiveBytes.fetch_add(static_cast<int64_t>(_szSize), std::memory_order_relaxed);
+    s_i64Allocs.fetch_add(1, std::memory_order_relaxed);
+    return ptrBlock + s_szHeader;
+}
+
+static void countedFree(void *_ptr) {
+    if (_ptr == nullptr)
+        return;
+    uint8_t *ptrBlock(static_cast<uint8_t *>(_ptr) - s_szHeader);
+    s_i64LiveBytes.fetch_sub(static_cast<int64_t>(*reinterpret_cast<size_t *>(ptrBlock)), std::memory_order_relaxed);
+    std::free(ptrBlock);
+}
+
+void *operator new(size_t _szSize) { return countedAlloc(_szSize); }
+void *operator new[](size_t _szSize) { return countedAlloc(_szSize); }
+void operator delete(void *_ptr) noexcept { countedFree(_ptr); }
+void operator delete[](void *_ptr) noexcept { countedFree(_ptr); }
+void operator delete(void *_ptr, size_t) noexcept { countedFree(_ptr); }
+void operator delete[](void *_ptr, size_t) noexcept { countedFree(_ptr); }
+
+
+
+/*
+** Measure
+* Heap bytes and allocation calls of an instance holding a value, over many samples,
+* as the hops, key sizes and padding are drawn at random on each write
+*/
+
+struct Sfootprint {
+    int64_t     m_i64BytesSum   = 0,
+                m_i64BytesMax   = 0,
+                m_i64AllocsSum  = 0,
+                m_i64AllocsMax  = 0;
+    int         m_iSamples      = 0,
+                m_iUnaccounted  = 0,    // Samples whose heap bytes differ from memory_usage()
+                m_iLeaks        = 0;    // Samples leaving bytes once destroyed
+};
+
+template <typename T>
+static Sfootprint measure(const T &_val, const int _iSamples) {
+    Sfootprint fpRet;
+    for (int i(0); i < _iSamples; ++i) {
+        int64_t i64BytesBeg(s_i64LiveBytes.load()),
+                i64AllocsBeg(s_i64Allocs.load());
+        {
+            // The instance itself is on the stack, only its heap is counted
+            CvarObfuscated<T> ovVariable;
+            ovVariable = _val;
+
+            int64_t i64Bytes(s_i64LiveBytes.load() - i64BytesBeg),
+                    i64Allocs(s_i64Allocs.load() - i64AllocsBeg);
+            fpRet.m_i64BytesSum  += i64Bytes;
+            fpRet.m_i64BytesMax   = std::max(fpRet.m_i64BytesMax, i64Bytes);
+            fpRet.m_i64AllocsSum += i64Allocs;
+            fpRet.m_i64AllocsMax  = std::max(fpRet.m_i64AllocsMax, i64Allocs);
+            if (static_cast<int64_t>(ovVariable.memory_usage().total()) != i64Bytes)
+                ++fpRet.m_iUnaccounted;
+        }
+        if (s_i64LiveBytes.load() != i64BytesBeg)
+            ++fpRet.m_iLeaks;
+        ++fpRet.m_iSamples;
+    }
+    return fpRet;
+}
+
+static void printHeader(const int _iSamples) {
+    std::printf("%d samples per case, heap of a stack instance holding a value, overhead relative to the payload bytes\n\n", _iSamples);
+    std::printf("%-22s %8s %10s %10s %10s %10s %10s %10s %6s %6s\n",
+                "type", "payload", "allocs", "allocs", "bytes", "bytes", "overhead", "overhead", "unacc.", "leaks");
+    std::printf("%-22s %8s %10s %10s %10s %10s %10s %10s %6s %6s\n",
+                "", "", "mean", "max", "mean", "max", "mean", "max", "", "");
+}
+
+static void printCase(const char *_szType, const size_t _szPayload, const Sfootprint &_fp) {
+    double dBytesMean(static_cast<double>(_fp.m_i64BytesSum) / _fp.m_iSamples);
+    std::printf("%-22s %8zu %10.1f %10lld %10.1f %10lld %9.1fx %9.1fx %6d %6d\n", _szType, _szPayload,
+                static_cast<double>(_fp.m_i64AllocsSum) / _fp.m_iSamples, static_cast<long long>(_fp.m_i64AllocsMax),
+                dBytesMean, static_cast<long long>(_fp.m_i64BytesMax),
+                dBytesMean / _szPayload, static_cast<double>(_fp.m_i64BytesMax) / _szPayload,
+                _fp.m_iUnaccounted, _fp.m_iLeaks);
+}
+
+
+
+/*
+** Entry point
+* CvarObfuscated_footprint [SAMPLES]
+*/
+
+struct Sstats {
+    int32_t     m_i32Health;
+    int32_t     m_i32Mana;
+    float       m_fSpeed;
+};
+
+int main(int argc, char **argv) {
+    int iSamples((argc > 1) ? std::atoi(argv[1]) : 2000);
+    if (iSamples <= 0) {
+        std::fprintf(stderr, "usage: %s [SAMPLES]\n", argv[0]);
+        return 1;
+    }
+
+    // Fixed seed, the footprints are reproducible
+    ::srand(0x5EED);
+    bool bFailed(false);
+    auto report([&](const char *_szType, const size_t _szPayload, const Sfootprint &_fp) {
+        printCase(_szType, _szPayload, _fp);
+        bFailed |= (_fp.m_iUnaccounted != 0 || _fp.m_iLeaks != 0);
+    });
+
+    printHeader(iSamples);
+    report("uint8_t", sizeof(uint8_t), measure<uint8_t>(7, iSamples));
+    report("int32_t", sizeof(int32_t), measure<int32_t>(-7, iSamples));
+    report("int64_t", sizeof(int64_t), measure<int64_t>(7, iSamples));
+    report("double", sizeof(double), measure<double>(7.5, iSamples));
+    report("Sstats", sizeof(Sstats), measure<Sstats>(Sstats { 100, 50, 1.5f }, iSamples));
+    for (size_t szPayload : { 8, 64, 512, 4096 })
+        report("std::string", szPayload, measure<std::string>(std::string(szPayload, 'x'), iSamples));
+    for (size_t szPayload : { 8, 64, 512, 4096 })
+        report("std::vector<uint8_t>", szPayload, measure<std::vector<uint8_t>>(std::vector<uint8_t>(szPayload, 0x5A), iSamples));
+
+    // A footprint not matching the accounting, or a leak, fails the run
+    return bFailed ? 1 : 0;
+}
@@ -0,0 +1,137 @@
+#include "CvarObfuscated.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+
+/*
+** Entities
+* Every stat of an entity is obfuscated, the simulation reads and updates them each tick
+*/
+
+struct Svec3 {
+    float       m_fX,
+                m_fY,
+                m_fZ;
+};
+
+struct Sentity {
+    CvarObfuscated<int32_t>     m_ovHealth,
+                                m_ovMana;
+    CvarObfuscated<int64_t>     m_ovGold;
+    CvarObfuscated<float>       m_ovSpeed;
+    CvarObfuscated<Svec3>       m_ovPosition;
+    CvarObfuscated<uint8_t>     m_ovState;      // 0 alive, 1 dead
+};
+
+// One simulation tick of an entity, mixing reads, compound assignments, comparisons and struct updates
+static void tick(Sentity &_ent, const uint32_t _ui32Frame, const uint32_t _ui32Index) {
+    // Dead entities respawn after a while
+    if (_ent.m_ovState == uint8_t(1)) {
+        if ((_ui32Frame + _ui32Index) % 120 == 0) {
+            _ent.m_ovHealth = 100;
+            _ent.m_ovState = uint8_t(0);
+        }
+        return;
+    }
+
+    // Move along a direction depending on the entity
+    float fSpeed(_ent.m_ovSpeed);
+    Svec3 vecPos(_ent.m_ovPosition);
+    vecPos.m_fX += fSpeed * ((_ui32Index % 3) - 1.f) / 60.f;
+    vecPos.m_fZ += fSpeed * ((_ui32Index % 5) - 2.f) / 60.f;
+    _ent.m_ovPosition = vecPos;
+
+    // Regenerate the mana up to its maximum
+    if (_ent.m_ovMana < 100)
+        _ent.m_ovMana += 1;
+
+    // A quarter of the entities take damage, and may die
+    if ((_ui32Index + _ui32Frame) % 4 == 0) {
+        _ent.m_ovHealth -= 1 + static_cast<int32_t>(_ui32Index % 7);
+        if (_ent.m_ovHealth <= 0)
+            _ent.m_ovState = uint8_t(1);
+    }
+
+    // Some of them loot gold
+    if ((_ui32Index * 31 + _ui32Frame) % 16 == 0)
+        _ent.m_ovGold += 5;
+}
+
+
+
+/*
+** Entry point
+* CvarObfuscated_gameloop [ENTITIES] [FRAMES]
+* The frames are paced at 60 Hz, a frame longer than its budget delays the next one
+*/
+int main(int argc, char **argv) {
+    int iEntities((argc > 1) ? std::atoi(argv[1]) : 10000),
+        iFrames((argc > 2) ? std::atoi(argv[2]) : 300);
+    if (iEntities <= 0 || iFrames <= 0) {
+        std::fprintf(stderr, "usage: %s [ENTITIES] [FRAMES]\n", argv[0]);
+        return 1;
+    }
+
+    // Fixed seed, the specifications drawn by the library are reproducible
+    ::srand(0x5EED);
+
+    std::vector<std::unique_ptr<Sentity>> vecEntities;
+    for (int i(0); i < iEntities; ++i) {
+        vecEntities.emplace_back(new Sentity());
+        Sentity &ent(*vecEntities.back());
+        ent.m_ovHealth = 100;
+        ent.m_ovMana = i % 100;
+        ent.m_ovGold = 0;
+        ent.m_ovSpeed = 1.f + static_cast<float>(i % 10);
+        ent.m_ovPosition = Svec3 { static_cast<float>(i % 100), 0.f, static_cast<float>(i / 100) };
+        ent.m_ovState = uint8_t(0);
+    }
+
+    // Simulate the frames, each one starting at its 60 Hz deadline or right after the previous one if late
+    const std::chrono::nanoseconds nsBudget(1000000000 / 60);
+    std::vector<double> vecFrameMs, vecCpuMs;
+    int iMissed(0);
+    std::chrono::steady_clock::time_point tpNext(std::chrono::steady_clock::now());
+    for (int iFrame(0); iFrame < iFrames; ++iFrame) {
+        std::this_thread::sleep_until(tpNext);
+
+        std::chrono::steady_clock::time_point tpBeg(std::chrono::steady_clock::now());
+        std::clock_t clkBeg(std::clock());
+        for (size_t i(0); i < vecEntities.size(); ++i)
+            tick(*vecEntities[i], static_cast<uint32_t>(iFrame), static_cast<uint32_t>(i));
+        std::clock_t clkEnd(std::clock());
+        std::chrono::nanoseconds nsFrame(std::chrono::steady_clock::now() - tpBeg);
+
+        vecFrameMs.push_back(nsFrame.count() / 1e6);
+        vecCpuMs.push_back(1000. * (clkEnd - clkBeg) / CLOCKS_PER_SEC);
+        if (nsFrame > nsBudget)
+            ++iMissed;
+        tpNext = std::max(tpNext + nsBudget, std::chrono::steady_clock::now());
+    }
+
+    // Frame time distribution
+    std::vector<double> vecSorted(vecFrameMs);
+    std::sort(vecSorted.begin(), vecSorted.end());
+    auto percentile([&](const double _dQuantile) {
+        return vecSorted[std::min(vecSorted.size() - 1, static_cast<size_t>(_dQuantile * vecSorted.size()))];
+    });
+    double dCpuMean(0);
+    for (double dCpu : vecCpuMs)
+        dCpuMean += dCpu / vecCpuMs.size();
+
+    std::printf("%d entities, 6 obfuscated stats each, %d frames at 60 Hz (budget %.2f ms)\n\n", iEntities, iFrames, nsBudget.count() / 1e6);
+    std::printf("frame time ms   p50 %8.2f   p90 %8.2f   p99 %8.2f   max %8.2f\n", percentile(0.5), percentile(0.9), percentile(0.99), vecSorted.back());
+    std::printf("cpu per frame   mean %7.2f ms   per entity %.2f us\n", dCpuMean, 1000. * dCpuMean / iEntities);
+    std::printf("missed frames   %d / %d\n", iMissed, iFrames);
+
+    return 0;
+}
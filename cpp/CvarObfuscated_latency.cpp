@@ -0,0 +1,212 @@
+#include "CvarObfuscated.hpp"
+
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+
+
+/*
+** ShdrHistogram
+* Log linear histogram of latencies in nanoseconds (HDR histogram layout), 2048 sub buckets per power of two,
+* every recorded value is kept with a relative error below 0.1 %
+*
+*     +-------------------+--------------------+--------------------+-----+
+*     | 0 .. 2047 (exact) | 2048 .. 4095 (x2)  | 4096 .. 8191 (x4)  | ... |
+*     +-------------------+--------------------+--------------------+-----+
+*/
+
+struct ShdrHistogram {
+    ShdrHistogram() : m_vecCounts(s_szSubCount + (s_iMaxExp - 1) * (s_szSubCount / 2), 0) {}
+
+    // Count a value, clamped to the highest trackable one
+    void record(uint64_t _ui64Val) {
+        _ui64Val = std::min<uint64_t>(_ui64Val, (1ull << (s_iMaxExp + s_iSubBits - 1)) - 1);
+        ++m_vecCounts[_index(_ui64Val)];
+        ++m_ui64Total;
+        m_ui64Max = std::max(m_ui64Max, _ui64Val);
+    }
+
+    // Highest value equivalent to the given quantile (0 .. 1)
+    uint64_t percentile(const double _dQuantile) const {
+        uint64_t ui64Rank(static_cast<uint64_t>(std::ceil(_dQuantile * static_cast<double>(m_ui64Total)))),
+                 ui64Sum(0);
+        ui64Rank = std::max<uint64_t>(ui64Rank, 1);
+        for (size_t i(0); i < m_vecCounts.size(); ++i) {
+            ui64Sum += m_vecCounts[i];
+            if (ui64Sum >= ui64Rank)
+                return std::min(_highest(i), m_ui64Max);
+        }
+        return m_ui64Max;
+    }
+
+    uint64_t total() const { return m_ui64Total; }
+    uint64_t max() const { return m_ui64Max; }
+
+private:
+    // Exact index below the sub bucket count, then half of the sub buckets for each power of two above
+    size_t _index(const uint64_t _ui64Val) const {
+        if (_ui64Val < s_szSubCount)
+            return static_cast<size_t>(_ui64Val);
+        int iExp(static_cast<int>(std::bit_width(_ui64Val)) - s_iSubBits);
+        return s_szSubCount + (iExp - 1) * (s_szSubCount / 2) + static_cast<size_t>((_ui64Val >> iExp) - s_szSubCount / 2);
+    }
+
+    // Highest value counted in a bucket
+    uint64_t _highest(const size_t _szIndex) const {
+        if (_szIndex < s_szSubCount)
+            return _szIndex;
+        size_t szExp((_szIndex - s_szSubCount) / (s_szSubCount / 2) + 1),
+               szSub((_szIndex - s_szSubCount) % (s_szSubCount / 2) + s_szSubCount / 2);
+        return ((static_cast<uint64_t>(szSub) + 1) << szExp) - 1;
+    }
+
+    static constexpr int    s_iSubBits      = 11;
+    static constexpr size_t s_szSubCount    = size_t(1) << s_iSubBits;
+    static constexpr int    s_iMaxExp       = 30;   // Up to ~2^40 ns
+
+    std::vector<uint64_t>   m_vecCounts;
+    uint64_t                m_ui64Total     = 0,
+                            m_ui64Max       = 0;
+};
+
+
+
+/*
+** Open loop driver
+* The operations are scheduled at a fixed rate, each latency is measured from its intended start time:
+* a stall delays the next operations and is counted in their latencies, instead of being omitted
+*/
+
+struct Sconfig {
+    double      m_dRate         = 20000.;   // Operations per second
+    double      m_dDuration     = 2.;       // Seconds per case
+    uint64_t    m_ui64Seed      = 0x5EED;
+};
+
+static ShdrHistogram runOpenLoop(const Sconfig &_cfg, const std::function<void(const uint64_t)> &_fnOp) {
+    // Warm up the caches and the allocator
+    for (uint64_t i(0); i < 1000; ++i)
+        _fnOp(i);
+
+    ShdrHistogram hdrRet;
+    std::chrono::nanoseconds nsPeriod(static_cast<int64_t>(1e9 / _cfg.m_dRate));
+    uint64_t ui64OpNbr(static_cast<uint64_t>(_cfg.m_dRate * _cfg.m_dDuration));
+    std::chrono::steady_clock::time_point tpStart(std::chrono::steady_clock::now());
+
+    for (uint64_t i(0); i < ui64OpNbr; ++i) {
+        // Wait for the intended start time, or start right away if late
+        std::chrono::steady_clock::time_point tpIntended(tpStart + nsPeriod * i);
+        while (std::chrono::steady_clock::now() < tpIntended)
+            ;
+        _fnOp(i);
+        hdrRet.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tpIntended).count()));
+    }
+    return hdrRet;
+}
+
+static void printHeader(const Sconfig &_cfg) {
+    std::printf("rate %.0f ops/s, %.1f s per case, seed 0x%llX, latencies in ns from the intended start\n\n",
+                _cfg.m_dRate, _cfg.m_dDuration, static_cast<unsigned long long>(_cfg.m_ui64Seed));
+    std::printf("%-14s %-12s %10s %10s %10s %10s %10s %12s\n", "operator", "type", "count", "p50", "p90", "p99", "p99.9", "max");
+}
+
+static void printCase(const char *_szOperator, const char *_szType, const ShdrHistogram &_hdr) {
+    std::printf("%-14s %-12s %10llu %10llu %10llu %10llu %10llu %12llu\n", _szOperator, _szType,
+                static_cast<unsigned long long>(_hdr.total()),
+                static_cast<unsigned long long>(_hdr.percentile(0.5)),
+                static_cast<unsigned long long>(_hdr.percentile(0.9)),
+                static_cast<unsigned long long>(_hdr.percentile(0.99)),
+                static_cast<unsigned long long>(_hdr.percentile(0.999)),
+                static_cast<unsigned long long>(_hdr.max()));
+}
+
+
+
+/*
+** Cases
+* Every operator of a type on a fresh instance, the operands are drawn beforehand from the seeded generator
+*/
+
+struct Sstats {
+    int32_t     m_i32Health;
+    int32_t     m_i32Mana;
+    float       m_fSpeed;
+};
+
+// Keep a result alive without a benchmark library
+static volatile uintptr_t s_uiSink(0);
+
+template <typename T>
+static void keepAlive(T *_ptr) {
+    s_uiSink = reinterpret_cast<uintptr_t>(_ptr) ^ static_cast<uintptr_t>(*reinterpret_cast<volatile uint8_t *>(_ptr));
+}
+
+template <typename T>
+static void runType(const Sconfig &_cfg, const char *_szType, std::mt19937_64 &_rng, const std::function<T(std::mt19937_64 &)> &_fnGen) {
+    std::vector<T> vecPool;
+    for (int i(0); i < 1024; ++i)
+        vecPool.push_back(_fnGen(_rng));
+
+    auto runCase([&](const char *_szOperator, const std::function<void(CvarObfuscated<T> &, const T &)> &_fnOp) {
+        CvarObfuscated<T> ovVariable;
+        ovVariable = vecPool[0];
+        printCase(_szOperator, _szType, runOpenLoop(_cfg, [&](const uint64_t _ui64Op) {
+            _fnOp(ovVariable, vecPool[_ui64Op % vecPool.size()]);
+        }));
+    });
+
+    runCase("get", [](CvarObfuscated<T> &_ov, const T &) { T val(_ov); keepAlive(&val); });
+    runCase("=", [](CvarObfuscated<T> &_ov, const T &_val) { _ov = _val; });
+    if constexpr (std::is_arithmetic_v<T>) {
+        runCase("+=", [](CvarObfuscated<T> &_ov, const T &_val) { _ov += _val; });
+        runCase("==", [](CvarObfuscated<T> &_ov, const T &_val) { bool bRet(_ov == _val); keepAlive(&bRet); });
+        runCase("fetch_add", [](CvarObfuscated<T> &_ov, const T &_val) { T val(_ov.fetch_add(_val)); keepAlive(&val); });
+    }
+    if constexpr (std::is_same_v<T, std::string>)
+        runCase("==", [](CvarObfuscated<T> &_ov, const T &_val) { bool bRet(_ov == _val); keepAlive(&bRet); });
+}
+
+
+
+/*
+** Entry point
+* CvarObfuscated_latency [--rate=OPS_PER_SECOND] [--duration=SECONDS] [--seed=SEED]
+*/
+int main(int argc, char **argv) {
+    Sconfig cfg;
+    for (int i(1); i < argc; ++i) {
+        std::string strArg(argv[i]);
+        if (strArg.rfind("--rate=", 0) == 0)
+            cfg.m_dRate = std::stod(strArg.substr(7));
+        else if (strArg.rfind("--duration=", 0) == 0)
+            cfg.m_dDuration = std::stod(strArg.substr(11));
+        else if (strArg.rfind("--seed=", 0) == 0)
+            cfg.m_ui64Seed = std::stoull(strArg.substr(7), nullptr, 0);
+        else {
+            std::fprintf(stderr, "usage: %s [--rate=OPS_PER_SECOND] [--duration=SECONDS] [--seed=SEED]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // The library draws its specifications from rand(), seeded as the operands
+    ::srand(static_cast<unsigned int>(cfg.m_ui64Seed));
+    std::mt19937_64 rng(cfg.m_ui64Seed);
+
+    printHeader(cfg);
+    runType<int32_t>(cfg, "int32_t", rng, [](std::mt19937_64 &_rng) { return static_cast<int32_t>(_rng() % 1000); });
+    runType<int64_t>(cfg, "int64_t", rng, [](std::mt19937_64 &_rng) { return static_cast<int64_t>(_rng() % 1000000); });
+    runType<double>(cfg, "double", rng, [](std::mt19937_64 &_rng) { return static_cast<double>(_rng() % 1000) / 7.; });
+    runType<std::string>(cfg, "std::string", rng, [](std::mt19937_64 &_rng) { return std::string(16 + _rng() % 48, static_cast<char>('a' + _rng() % 26)); });
+    runType<Sstats>(cfg, "Sstats", rng, [](std::mt19937_64 &_rng) {
+        return Sstats { static_cast<int32_t>(_rng() % 100), static_cast<int32_t>(_rng() % 100), static_cast<float>(_rng() % 10) };
+    });
+
+    return 0;
+}
@@ -1,5 +1,14 @@
 #include "CvarObfuscated.hpp"
 
+#include <thread>
+#include <sstream>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#if !defined(_WIN32)
+    #include <sys/wait.h>
+#endif
+
 
 #if !defined(SK_BENCHMARK)
     #define execute (main)
@@ -7,6 +16,35 @@
 
 
 
+/*
+** Allocation recorder
+* The hop nodes are single words, the addresses of the word sized allocations are recorded while enabled,
+* so a test can corrupt a hop chain as an attacker would
+* An allocation can also be made to fail, to test the recovery of the operations
+*/
+static std::atomic<bool>    s_bRecordWords(false);
+static std::atomic<int>     s_iWords(0),
+                            s_iFailIn(-1);  // Allocations left before one fails, -1 for none
+static void                *s_arrWords[64];
+
+void *operator new(size_t _szSize) {
+    if (s_iFailIn.load(std::memory_order_relaxed) >= 0 && s_iFailIn.fetch_sub(1) == 0)
+        throw std::bad_alloc();
+    void *ptrRet(std::malloc(_szSize ? _szSize : 1));
+    if (ptrRet == nullptr)
+        throw std::bad_alloc();
+    if (_szSize == sizeof(intptr_t) && s_bRecordWords.load(std::memory_order_relaxed)) {
+        int iIndex(s_iWords.fetch_add(1));
+        if (iIndex < 64)
+            s_arrWords[iIndex] = ptrRet;
+    }
+    return ptrRet;
+}
+void operator delete(void *_ptr) noexcept { std::free(_ptr); }
+void operator delete(void *_ptr, size_t) noexcept { std::free(_ptr); }
+
+
+
 /*
 ** Unitary tests
 * 
@@ -547,6 +585,700 @@ void unitaryTest() {
         if (iB2 != 0x01000100) throw std::runtime_error("TEST var ^ var #2:B FAILED");
         if (iRet2 != 0x01010001) throw std::runtime_error("TEST var ^ var #2:C FAILED");
     }
+    {
+        CvarObfuscated<int32_t> ovA;
+
+
+        ovA = 50;
+        int32_t iRet1(ovA++);
+        int32_t iRet2(ovA--);
+        int32_t iRet3(ovA);
+
+        if (iRet1 != 50) throw std::runtime_error("TEST var++ #3 FAILED");
+        if (iRet2 != 51) throw std::runtime_error("TEST var-- #3 FAILED");
+        if (iRet3 != 50) throw std::runtime_error("TEST var-- #4 FAILED");
+    }
+    {
+        CvarObfuscated<int32_t> ovA;
+
+
+        ovA.store(10);
+
+        if (ovA.fetch_add(5) != 10) throw std::runtime_error("TEST fetch_add #1 FAILED");
+        if (ovA.fetch_sub(3) != 15) throw std::runtime_error("TEST fetch_sub #1 FAILED");
+        if (ovA.exchange(100) != 12) throw std::runtime_error("TEST exchange #1 FAILED");
+        if (ovA.load() != 100) throw std::runtime_error("TEST load #1 FAILED");
+
+
+        int32_t iExpected(99);
+
+        if (ovA.compare_exchange_strong(iExpected, 7) != false) throw std::runtime_error("TEST compare_exchange_strong #1:A FAILED");
+        if (iExpected != 100) throw std::runtime_error("TEST compare_exchange_strong #1:B FAILED");
+        if (ovA.compare_exchange_strong(iExpected, 7) != true) throw std::runtime_error("TEST compare_exchange_strong #2:A FAILED");
+        if (ovA.load() != 7) throw std::runtime_error("TEST compare_exchange_strong #2:B FAILED");
+    }
+    {
+        CvarObfuscated<bool> ovA;
+        std::atomic<bool>    atomWoken(false);
+
+
+        ovA = false;
+
+        std::thread thrWaiter([&]() {
+            ovA.wait(false);
+            atomWoken = true;
+        });
+
+        ovA = true;
+        ovA.notify_all();
+        thrWaiter.join();
+
+        if (atomWoken != true) throw std::runtime_error("TEST wait/notify #1 FAILED");
+    }
+    {
+        auto strDec(MESCAMIT_STR("wCq1PrX4g9Lm0kTzV"));
+
+        if (::strcmp(strDec.c_str(), "wCq1PrX4g9Lm0kTzV") != 0) throw std::runtime_error("TEST MESCAMIT_STR #1 FAILED");
+        if (strDec.size() != 17) throw std::runtime_error("TEST MESCAMIT_STR #2 FAILED");
+        if (MESCAMIT_STR("").view() != "") throw std::runtime_error("TEST MESCAMIT_STR #3 FAILED");
+
+
+        CvarObfuscated<std::string> ovA;
+
+        ovA = std::string(MESCAMIT_STR("r3Kd0").view());
+
+        if (ovA != "r3Kd0") throw std::runtime_error("TEST MESCAMIT_STR #4 FAILED");
+    }
+    {
+        static constinit CvarObfuscatedConst<int32_t, MESCAMIT_SEED> s_ocA(INT32_MIN);
+        static const auto s_ocB(MESCAMIT_CONST(double, 3.25));
+        static const auto s_ocC(MESCAMIT_CONST(uint64_t, UINT64_MAX - 1));
+
+        if (s_ocA.get() != INT32_MIN) throw std::runtime_error("TEST CvarObfuscatedConst #1 FAILED");
+        if (s_ocB != 3.25) throw std::runtime_error("TEST CvarObfuscatedConst #2 FAILED");
+        if (s_ocC.get() != UINT64_MAX - 1) throw std::runtime_error("TEST CvarObfuscatedConst #3 FAILED");
+    }
+    {
+        CvarObfuscatedWord<bool> owA;
+        CvarObfuscatedWord<int32_t> owB(-5);
+
+
+        if (owA != false) throw std::runtime_error("TEST CvarObfuscatedWord<bool> #1 FAILED");
+        owA = true;
+        if (owA != true) throw std::runtime_error("TEST CvarObfuscatedWord<bool> #2 FAILED");
+
+        if (owB.load() != -5) throw std::runtime_error("TEST CvarObfuscatedWord<int32_t> #1 FAILED");
+        if (owB++ != -5 || ++owB != -3) throw std::runtime_error("TEST CvarObfuscatedWord<int32_t> #2 FAILED");
+        if ((owB += 10) != 7) throw std::runtime_error("TEST CvarObfuscatedWord<int32_t> #3 FAILED");
+        owB = 0x00001100;
+        if ((owB ^= 0x00000101) != 0x00001001) throw std::runtime_error("TEST CvarObfuscatedWord<int32_t> #4 FAILED");
+        if ((owB &= 0x00001000) != 0x00001000) throw std::runtime_error("TEST CvarObfuscatedWord<int32_t> #5 FAILED");
+        if ((owB |= 0x00000011) != 0x00001011) throw std::runtime_error("TEST CvarObfuscatedWord<int32_t> #6 FAILED");
+
+
+        int32_t iExpected(1);
+
+        if (owB.compare_exchange_strong(iExpected, 2) != false || iExpected != 0x00001011) throw std::runtime_error("TEST CvarObfuscatedWord<int32_t> #7 FAILED");
+        if (owB.compare_exchange_strong(iExpected, 2) != true || owB.load() != 2) throw std::runtime_error("TEST CvarObfuscatedWord<int32_t> #8 FAILED");
+
+
+        std::vector<std::thread> vecThr;
+        owB = 0;
+        for (int i(0); i < 4; ++i)
+            vecThr.emplace_back([&]() { for (int j(0); j < 1000; ++j) ++owB; });
+        for (std::thread &thr : vecThr)
+            thr.join();
+
+        if (owB != 4000) throw std::runtime_error("TEST CvarObfuscatedWord<int32_t> #9 FAILED");
+    }
+    {
+        CvarObfuscatedBitset<200> obA;
+
+
+        if (obA.any() != false || obA.count() != 0) throw std::runtime_error("TEST CvarObfuscatedBitset #1 FAILED");
+
+        obA.set(0);
+        obA.set(63);
+        obA.set(64);
+        obA.set(199);
+
+        if (!obA.test(0) || !obA.test(63) || !obA.test(64) || !obA.test(199) || obA.test(100)) throw std::runtime_error("TEST CvarObfuscatedBitset #2 FAILED");
+        if (obA.count() != 4) throw std::runtime_error("TEST CvarObfuscatedBitset #3 FAILED");
+
+        obA.reset(63);
+        obA.set(64, false);
+
+        if (obA.test(63) || obA.test(64) || obA.count() != 2) throw std::runtime_error("TEST CvarObfuscatedBitset #4 FAILED");
+    }
+    {
+        const uint64_t ui64Key(0x6A09E667F3BCC908ull);
+        CvarObfuscated<int32_t> ovA;
+        CvarObfuscated<std::string> ovB;
+        CvarObfuscated<std::vector<int64_t>> ovC;
+        CvarObfuscated<int32_t> ovD;
+
+
+        ovA.persist("test.ovA");
+        ovB.persist("test.ovB");
+        ovC.persist("test.ovC");
+
+        ovA = 123456;
+        ovB = "Lq8Zt1bW";
+        ovC = std::vector<int64_t> { INT64_MIN, 0, INT64_MAX };
+        ovD = 42;
+
+        if (CvarObfuscated<void>::snapshot("mescamit_snapshot.bin", ui64Key) != 3) throw std::runtime_error("TEST snapshot #1 FAILED");
+
+        ovA = 0;
+        ovB = "";
+        ovC = std::vector<int64_t> {};
+
+        if (CvarObfuscated<void>::restore("mescamit_snapshot.bin", ui64Key) != 3) throw std::runtime_error("TEST restore #1 FAILED");
+
+        if (ovA != 123456) throw std::runtime_error("TEST restore #2 FAILED");
+        if (ovB != "Lq8Zt1bW") throw std::runtime_error("TEST restore #3 FAILED");
+        if (ovC != std::vector<int64_t> { INT64_MIN, 0, INT64_MAX }) throw std::runtime_error("TEST restore #4 FAILED");
+        if (ovD != 42) throw std::runtime_error("TEST restore #5 FAILED");
+
+        bool bThrown(false);
+        try { ovD.persist("test.ovA"); }
+        catch (const std::runtime_error &) { bThrown = true; }
+        if (!bThrown) throw std::runtime_error("TEST persist duplicate FAILED");
+
+        CvarObfuscated<int64_t> ovE;
+        ovA.persist("");
+        ovE.persist("test.ovA");
+        ovE = 7;
+
+        bThrown = false;
+        try { CvarObfuscated<void>::restore("mescamit_snapshot.bin", ui64Key); }
+        catch (const std::runtime_error &) { bThrown = true; }
+        ::remove("mescamit_snapshot.bin");
+        if (!bThrown || ovE != 7 || ovB != "Lq8Zt1bW") throw std::runtime_error("TEST restore size FAILED");
+    }
+    {
+        std::vector<uint8_t> vecPlain(10000);
+        for (size_t i(0); i < vecPlain.size(); ++i)
+            vecPlain[i] = static_cast<uint8_t>(i * 7 + 3);
+
+        {
+            std::ofstream ofs("mescamit_blob_plain.bin", std::ios::binary | std::ios::trunc);
+            ofs.write(reinterpret_cast<const char *>(vecPlain.data()), vecPlain.size());
+        }
+        CvarObfuscatedMappedBlob::encodeFile("mescamit_blob_plain.bin", "mescamit_blob.bin", 0x5EC12E7ull);
+        ::remove("mescamit_blob_plain.bin");
+
+        {
+            CvarObfuscatedMappedBlob omA("mescamit_blob.bin", 0x5EC12E7ull, 2);
+            std::vector<uint8_t> vecRet(vecPlain.size());
+
+            if (omA.size() != vecPlain.size()) throw std::runtime_error("TEST CvarObfuscatedMappedBlob #1 FAILED");
+
+            omA.read(4000, vecRet.data(), 5000);
+            if (::memcmp(vecRet.data(), vecPlain.data() + 4000, 5000) != 0) throw std::runtime_error("TEST CvarObfuscatedMappedBlob #2 FAILED");
+
+            omA.read(0, vecRet.data(), vecPlain.size());
+            if (vecRet != vecPlain) throw std::runtime_error("TEST CvarObfuscatedMappedBlob #3 FAILED");
+        }
+        ::remove("mescamit_blob.bin");
+    }
+    {
+        std::string strPlain;
+        for (int i(0); i < 20000; ++i)
+            strPlain.push_back(static_cast<char>('a' + (i * 13) % 26));
+
+        std::istringstream iss(strPlain);
+        CvarObfuscated<std::string> ovA;
+
+        if (ovA.assign_from(iss) != strPlain.size()) throw std::runtime_error("TEST assign_from #1 FAILED");
+        if (ovA != strPlain) throw std::runtime_error("TEST assign_from #2 FAILED");
+
+        std::istringstream issEmpty("");
+        ovA.assign_from(issEmpty);
+
+        if (ovA != "") throw std::runtime_error("TEST assign_from #3 FAILED");
+
+
+        ovA = "kT2x";
+
+        bool bThrown(false);
+        try {
+            ovA.assign_from_fd(-1);
+        }
+        catch (const std::runtime_error &) {
+            bThrown = true;
+        }
+
+        if (bThrown != true) throw std::runtime_error("TEST assign_from_fd #1 FAILED");
+        if (ovA != "kT2x") throw std::runtime_error("TEST assign_from_fd #2 FAILED");
+    }
+    {
+        std::string strPlain;
+        for (int i(0); i < 10000; ++i)
+            strPlain.push_back(static_cast<char>('A' + (i * 7) % 26));
+
+        CvarObfuscated<std::string> ovA;
+        ovA = strPlain;
+
+        std::ostringstream oss;
+        if (ovA.write_to(oss) != strPlain.size()) throw std::runtime_error("TEST write_to #1 FAILED");
+        if (oss.str() != strPlain) throw std::runtime_error("TEST write_to #2 FAILED");
+
+        std::ostringstream ossOperator;
+        ossOperator << ovA;
+        if (ossOperator.str() != strPlain) throw std::runtime_error("TEST operator<< #1 FAILED");
+
+        CvarObfuscated<int32_t> ovB;
+        ovB = 0x01020304;
+
+        std::ostringstream ossInt;
+        int32_t i32Ret(0);
+        if (ovB.write_to(ossInt) != sizeof(int32_t)) throw std::runtime_error("TEST write_to #3 FAILED");
+        ::memcpy(&i32Ret, ossInt.str().data(), sizeof(int32_t));
+        if (i32Ret != 0x01020304) throw std::runtime_error("TEST write_to #4 FAILED");
+
+        bool bThrown(false);
+        try {
+            ovA.write_to(-1);
+        }
+        catch (const std::runtime_error &) {
+            bThrown = true;
+        }
+
+        if (bThrown != true) throw std::runtime_error("TEST write_to #5 FAILED");
+    }
+    {
+        CvarObfuscatedShared<int64_t>::unlink("mescamit_test_shared");
+
+        // Two mappings of the same segment, as two processes would do
+        CvarObfuscatedShared<int64_t> osA("mescamit_test_shared");
+        CvarObfuscatedShared<int64_t> osB("mescamit_test_shared");
+
+        if (osB != 0) throw std::runtime_error("TEST CvarObfuscatedShared #1 FAILED");
+
+        osA = INT64_MIN + 5;
+        if (osB != INT64_MIN + 5) throw std::runtime_error("TEST CvarObfuscatedShared #2 FAILED");
+
+        osB += 10;
+        if (osA.fetch_sub(3) != INT64_MIN + 15) throw std::runtime_error("TEST CvarObfuscatedShared #3 FAILED");
+
+        int64_t i64Expected(0);
+        if (osB.compare_exchange_strong(i64Expected, 1) || i64Expected != INT64_MIN + 12) throw std::runtime_error("TEST CvarObfuscatedShared #4 FAILED");
+        if (!osA.compare_exchange_strong(i64Expected, 1) || osB != 1) throw std::runtime_error("TEST CvarObfuscatedShared #5 FAILED");
+
+        std::vector<std::thread> vecThreads;
+        for (int i(0); i < 4; ++i)
+            vecThreads.emplace_back([&, i]() {
+                CvarObfuscatedShared<int64_t> &osRef(i % 2 ? osA : osB);
+                for (int j(0); j < 1000; ++j)
+                    osRef.fetch_add(1);
+            });
+        for (std::thread &thread : vecThreads)
+            thread.join();
+
+        if (osA != 4001) throw std::runtime_error("TEST CvarObfuscatedShared #6 FAILED");
+
+        bool bThrown(false);
+        try {
+            CvarObfuscatedShared<int32_t> osC("mescamit_test_shared");
+        }
+        catch (const std::runtime_error &) {
+            bThrown = true;
+        }
+
+        if (bThrown != true) throw std::runtime_error("TEST CvarObfuscatedShared #7 FAILED");
+
+        CvarObfuscatedShared<int64_t>::unlink("mescamit_test_shared");
+    }
+#if !defined(_WIN32)
+    {
+        // Run a function in a child process, its exit code, or -1 if it is still running after the timeout
+        auto runChild([](auto _fnChild, const int _iTimeoutMs) -> int {
+            pid_t pidChild(::fork());
+            if (pidChild == 0)
+                ::_exit(_fnChild());
+            int iStatus(0);
+            for (int i(0); i < _iTimeoutMs; ++i) {
+                if (::waitpid(pidChild, &iStatus, WNOHANG) == pidChild)
+                    return WIFEXITED(iStatus) ? WEXITSTATUS(iStatus) : -1;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            ::kill(pidChild, SIGKILL);
+            ::waitpid(pidChild, &iStatus, 0);
+            return -1;
+        });
+
+        // Two processes opening the segment together, only one of them initializes it
+        CvarObfuscatedShared<int64_t>::unlink("mescamit_test_shared_fork");
+        pid_t pidChild(::fork());
+        if (pidChild == 0) {
+            CvarObfuscatedShared<int64_t> osChild("mescamit_test_shared_fork");
+            for (int i(0); i < 1000; ++i)
+                osChild.fetch_add(1);
+            ::_exit(0);
+        }
+        {
+            CvarObfuscatedShared<int64_t> osParent("mescamit_test_shared_fork");
+            for (int i(0); i < 1000; ++i)
+                osParent.fetch_add(1);
+            int iStatus(0);
+            ::waitpid(pidChild, &iStatus, 0);
+            if (!WIFEXITED(iStatus) || WEXITSTATUS(iStatus) != 0 || osParent != 2000) throw std::runtime_error("TEST CvarObfuscatedShared fork #1 FAILED");
+        }
+        if (runChild([]() { CvarObfuscatedShared<int64_t> osChild("mescamit_test_shared_fork"); return (osChild == 2000) ? 0 : 1; }, 5000) != 0)
+            throw std::runtime_error("TEST CvarObfuscatedShared fork #2 FAILED");
+        CvarObfuscatedShared<int64_t>::unlink("mescamit_test_shared_fork");
+
+        // A process terminated while initializing the segment, the segment starts with the state and the initializing process
+        if (runChild([]() {
+                int iFd(::shm_open("/mescamit_test_shared_fork", O_RDWR | O_CREAT, 0600));
+                uint32_t ui32Header[2] { 1, static_cast<uint32_t>(::getpid()) };
+                bool bWritten(iFd >= 0 && ::write(iFd, ui32Header, sizeof(ui32Header)) == static_cast<ssize_t>(sizeof(ui32Header)));
+                return bWritten ? 0 : 1;
+            }, 5000) != 0)
+            throw std::runtime_error("TEST CvarObfuscatedShared fork #3 FAILED");
+
+        // The next process takes the initialization over instead of waiting forever
+        if (runChild([]() { CvarObfuscatedShared<int64_t> osChild("mescamit_test_shared_fork"); osChild += 7; return (osChild == 7) ? 0 : 1; }, 5000) != 0)
+            throw std::runtime_error("TEST CvarObfuscatedShared fork #4 FAILED");
+        CvarObfuscatedShared<int64_t>::unlink("mescamit_test_shared_fork");
+    }
+#endif
+    {
+        std::string strPlain;
+        for (int i(0); i < 400; ++i)
+            strPlain += "{\"id\":" + std::to_string(i) + ",\"name\":\"entity\",\"enabled\":true},";
+
+        CvarObfuscated<std::string> ovA;
+        ovA.set_compression(true);
+
+        ovA = strPlain;
+        if (ovA != strPlain) throw std::runtime_error("TEST compression #1 FAILED");
+
+        std::ostringstream oss;
+        ovA.write_to(oss);
+        if (oss.str() != strPlain) throw std::runtime_error("TEST compression #2 FAILED");
+
+        // Too small, or not compressible enough, stored as is
+        ovA = "short";
+        if (ovA != "short") throw std::runtime_error("TEST compression #3 FAILED");
+
+        std::string strNoise;
+        for (int i(0); i < 2000; ++i)
+            strNoise.push_back(static_cast<char>(::rand() % 256));
+        ovA = strNoise;
+        if (ovA != strNoise) throw std::runtime_error("TEST compression #4 FAILED");
+
+        std::vector<uint8_t> vecComp(strPlain.size()),
+                             vecPlain(strPlain.size());
+        int iCompSize(Scompressor::compress(reinterpret_cast<const uint8_t *>(strPlain.data()), static_cast<int>(strPlain.size()), vecComp.data(), static_cast<int>(vecComp.size())));
+        if (iCompSize <= 0 || iCompSize > static_cast<int>(strPlain.size()) / 4) throw std::runtime_error("TEST Scompressor #1 FAILED");
+        if (!Scompressor::decompress(vecComp.data(), iCompSize, vecPlain.data(), static_cast<int>(vecPlain.size()))) throw std::runtime_error("TEST Scompressor #2 FAILED");
+        if (::memcmp(vecPlain.data(), strPlain.data(), strPlain.size()) != 0) throw std::runtime_error("TEST Scompressor #3 FAILED");
+        if (Scompressor::decompress(vecComp.data(), iCompSize / 2, vecPlain.data(), static_cast<int>(vecPlain.size()))) throw std::runtime_error("TEST Scompressor #4 FAILED");
+    }
+    {
+        CvarObfuscated<int64_t> ovA;
+        CvarObfuscated<std::string> ovB;
+
+        ovA = 77;
+        ovA.set_integrity(true);
+        ovB.set_integrity(true);
+        ovB.set_compression(true);
+
+        if (ovA != 77) throw std::runtime_error("TEST integrity #1 FAILED");
+        ovA += 3;
+        if (ovA != 80) throw std::runtime_error("TEST integrity #2 FAILED");
+
+        std::string strPlain(3000, 'x');
+        ovB = strPlain;
+        if (ovB != strPlain) throw std::runtime_error("TEST integrity #3 FAILED");
+
+        std::istringstream iss("Zm4qR7");
+        ovB.assign_from(iss);
+        if (ovB != "Zm4qR7") throw std::runtime_error("TEST integrity #4 FAILED");
+
+        // A single flipped bit, anywhere, changes the checksum
+        uint8_t ui8Buff[37];
+        for (int i(0); i < 37; ++i)
+            ui8Buff[i] = static_cast<uint8_t>(i * 11);
+        uint64_t ui64Hash(Sintegrity::hash(ui8Buff, 37, 0x1234));
+        for (int i(0); i < 37 * 8; ++i) {
+            ui8Buff[i / 8] ^= static_cast<uint8_t>(1 << (i % 8));
+            if (Sintegrity::hash(ui8Buff, 37, 0x1234) == ui64Hash) throw std::runtime_error("TEST Sintegrity #1 FAILED");
+            ui8Buff[i / 8] ^= static_cast<uint8_t>(1 << (i % 8));
+        }
+        if (Sintegrity::hash(ui8Buff, 37, 0x1235) == ui64Hash) throw std::runtime_error("TEST Sintegrity #2 FAILED");
+    }
+    {
+        CvarObfuscated<int32_t> ovA;
+        CvarObfuscated<std::string> ovB;
+
+        ovA = 31337;
+        ovA.set_redundancy(true);
+        ovB.set_redundancy(true);
+        ovB.set_compression(true);
+
+        if (ovA != 31337) throw std::runtime_error("TEST redundancy #1 FAILED");
+        ovA++;
+        if (ovA.load() != 31338) throw std::runtime_error("TEST redundancy #2 FAILED");
+
+        std::string strPlain(2000, 'q');
+        ovB = strPlain;
+        if (ovB != strPlain) throw std::runtime_error("TEST redundancy #3 FAILED");
+        ovB = "";
+        if (ovB != "") throw std::runtime_error("TEST redundancy #4 FAILED");
+
+        std::istringstream iss("c8Hd1");
+        ovB.assign_from(iss);
+        if (ovB != "c8Hd1") throw std::runtime_error("TEST redundancy #5 FAILED");
+
+        ovA.set_redundancy(false);
+        ovA = 5;
+        if (ovA != 5) throw std::runtime_error("TEST redundancy #6 FAILED");
+
+        // Streamed by chunks, each of them compared with the shadow copy
+        std::string strLong(10000, 'r');
+        ovB.set_compression(false);
+        ovB = strLong;
+        std::ostringstream oss;
+        if (ovB.write_to(oss) != strLong.size() || oss.str() != strLong) throw std::runtime_error("TEST redundancy #7 FAILED");
+    }
+
+    {
+        static std::atomic<int> s_iViolations(0);
+        CvarObfuscated<void>::set_scan_callback([](const void *, const char *) { ++s_iViolations; });
+
+        CvarObfuscated<int> ovA, ovB, ovC;
+        CvarObfuscated<std::string> ovD;
+
+        ovA = 1;
+        ovA.set_integrity(true);
+        ovB.set_redundancy(true);
+        ovB = 2;
+        ovC = 3;
+        ovD.set_integrity(true);
+        ovD.set_redundancy(true);
+        ovD = std::string(300, 'z');
+
+        // ovC has no check enabled, and is not scanned
+        if (CvarObfuscated<void>::scan_step(SIZE_MAX, std::chrono::seconds(10)) != 3) throw std::runtime_error("TEST scanner #1 FAILED");
+        // A budget of one byte checks a single instance per step
+        if (CvarObfuscated<void>::scan_step(1, std::chrono::seconds(10)) != 1) throw std::runtime_error("TEST scanner #2 FAILED");
+
+        ovA += 5;
+        ovB.set_redundancy(false);
+        if (CvarObfuscated<void>::scan_step(SIZE_MAX, std::chrono::seconds(10)) != 2) throw std::runtime_error("TEST scanner #3 FAILED");
+
+        CvarObfuscated<void>::scan_start(std::chrono::milliseconds(1), 4096, std::chrono::microseconds(200));
+        for (int i(0); i < 200; ++i)
+            ovD = std::string(100 + i, 'y');
+        CvarObfuscated<void>::scan_stop();
+
+        if (s_iViolations != 0) throw std::runtime_error("TEST scanner #4 FAILED");
+        CvarObfuscated<void>::set_scan_callback(nullptr);
+    }
+    {
+        static std::atomic<int> s_iViolations(0);
+        CvarObfuscated<void>::set_scan_callback([](const void *, const char *) { ++s_iViolations; });
+
+        CvarObfuscated<int64_t> ovA;
+        ovA.set_integrity(true);
+        ovA.set_redundancy(true);
+
+        // Record the hop nodes of the value, the key and their shadow copies
+        s_iWords = 0;
+        s_bRecordWords = true;
+        ovA = 42;
+        s_bRecordWords = false;
+        int iWords(std::min(s_iWords.load(), 64));
+        if (iWords < 4) throw std::runtime_error("TEST scanner hops #1 FAILED");
+
+        // Every node in turn leads far outside any allocation, the scanner reports it instead of following it
+        for (int i(0); i < iWords; ++i) {
+            intptr_t *ptrHop(static_cast<intptr_t *>(s_arrWords[i])),
+                     iSaved(*ptrHop);
+            *ptrHop ^= intptr_t(1) << 44;
+            CvarObfuscated<void>::scan_step(SIZE_MAX, std::chrono::seconds(10));
+            *ptrHop = iSaved;
+            if (s_iViolations != i + 1) throw std::runtime_error("TEST scanner hops #2 FAILED");
+        }
+
+        CvarObfuscated<void>::scan_step(SIZE_MAX, std::chrono::seconds(10));
+        if (s_iViolations != iWords || ovA != 42) throw std::runtime_error("TEST scanner hops #3 FAILED");
+        CvarObfuscated<void>::set_scan_callback(nullptr);
+    }
+
+    {
+        size_t szBaseline(CvarObfuscated<void>::memory_usage().total());
+        {
+            CvarObfuscated<int32_t> ovA;
+            if (ovA.memory_usage().total() != 0) throw std::runtime_error("TEST memory #1 FAILED");
+
+            ovA = 7;
+            SmemoryUsage usage(ovA.memory_usage());
+            if (usage.m_szValues != sizeof(int32_t) || usage.m_szKeys < 32 || usage.m_szSpecs == 0 || usage.m_szHops < 2 * sizeof(intptr_t)) throw std::runtime_error("TEST memory #2 FAILED");
+            if (CvarObfuscated<void>::memory_usage().total() != szBaseline + usage.total()) throw std::runtime_error("TEST memory #3 FAILED");
+
+            // Over the budget, a single hop and the minimal padding
+            CvarObfuscated<void>::set_memory_budget(1);
+            ovA = 8;
+            usage = ovA.memory_usage();
+            if (usage.m_szHops != 2 * sizeof(intptr_t) || usage.m_szPadding != 4 * 8) throw std::runtime_error("TEST memory #4 FAILED");
+            if (ovA != 8) throw std::runtime_error("TEST memory #5 FAILED");
+            CvarObfuscated<void>::set_memory_budget(0);
+
+            ovA.set_redundancy(true);
+            if (ovA.memory_usage().m_szValues != 2 * sizeof(int32_t)) throw std::runtime_error("TEST memory #6 FAILED");
+        }
+        if (CvarObfuscated<void>::memory_usage().total() != szBaseline) throw std::runtime_error("TEST memory #7 FAILED");
+    }
+
+    {
+        CvarObfuscated<int64_t> ovA, ovB;
+        CvarObfuscated<std::string> ovC;
+
+        ovA = -42;
+        ovA.set_integrity(true);
+        ovA.set_redundancy(true);
+        ovB.set_relocation(true);
+        ovC.set_compression(true);
+        ovC = std::string(4000, 'w');
+
+        // ovB is empty, ovC is not relocatable
+        ovA.set_relocation(true);
+        if (CvarObfuscated<void>::trim() != 2) throw std::runtime_error("TEST trim #1 FAILED");
+        if (ovA != -42 || ovB != 0 || ovC != std::string(4000, 'w')) throw std::runtime_error("TEST trim #2 FAILED");
+
+        ovC.set_relocation(true);
+        ovB = 9;
+        CvarObfuscated<void>::trim_start(std::chrono::milliseconds(5));
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        ovA += 2;
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        CvarObfuscated<void>::trim_stop();
+        if (ovA != -40 || ovB != 9 || ovC != std::string(4000, 'w')) throw std::runtime_error("TEST trim #3 FAILED");
+
+        ovA.set_relocation(false);
+        if (CvarObfuscated<void>::trim() != 2) throw std::runtime_error("TEST trim #4 FAILED");
+    }
+
+    {
+        std::vector<std::unique_ptr<CvarObfuscated<int32_t>>> vecVars;
+        for (int i(0); i < 16; ++i) {
+            vecVars.emplace_back(new CvarObfuscated<int32_t>());
+            *vecVars.back() = i * 3;
+            vecVars.back()->set_relocation(true);
+        }
+        vecVars[5]->set_integrity(true);
+        vecVars[6]->set_redundancy(true);
+
+        // A null budget moves a single instance per step, a large one every instance once
+        if (CvarObfuscated<void>::relocate_step(std::chrono::microseconds(0)) != 1) throw std::runtime_error("TEST relocation #1 FAILED");
+        if (CvarObfuscated<void>::relocate_step(std::chrono::seconds(10)) != 16) throw std::runtime_error("TEST relocation #2 FAILED");
+
+        CvarObfuscated<void>::relocate_start(std::chrono::milliseconds(1), std::chrono::microseconds(50));
+        for (int j(0); j < 200; ++j)
+            *vecVars[j % 16] += 1;
+        vecVars.resize(8);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CvarObfuscated<void>::relocate_stop();
+
+        for (int i(0); i < 8; ++i)
+            if (*vecVars[i] != i * 3 + 200 / 16 + (i < 200 % 16 ? 1 : 0)) throw std::runtime_error("TEST relocation #3 FAILED");
+    }
+    {
+        CvarObfuscated<std::string> ovA;
+        ovA.set_relocation(true);
+        ovA = "relocated";
+        size_t szUsage(CvarObfuscated<void>::memory_usage().total());
+
+        // Each allocation of the relocation fails in turn, the previous value is kept as it was
+        bool bThrown(true);
+        for (int i(0); bThrown; ++i) {
+            bThrown = false;
+            s_iFailIn = i;
+            try { CvarObfuscated<void>::relocate_step(std::chrono::seconds(10)); } catch (const std::bad_alloc &) { bThrown = true; }
+            s_iFailIn = -1;
+
+            if (bThrown && CvarObfuscated<void>::memory_usage().total() != szUsage) throw std::runtime_error("TEST relocation failure #1 FAILED");
+            if (ovA != "relocated") throw std::runtime_error("TEST relocation failure #2 FAILED");
+        }
+    }
+
+    {
+        CvarObfuscated<uint16_t> ovHot, ovCold;
+
+        bool bThrown(false);
+        try { ovHot.set_adaptive_hops(true, 3, 2); } catch (const std::runtime_error &) { bThrown = true; }
+        if (!bThrown) throw std::runtime_error("TEST adaptive hops #1 FAILED");
+
+        // A cold instance gets the deepest chains on both sides
+        ovCold.set_adaptive_hops(true, 2, 6);
+        ovCold = 17;
+        if (ovCold.memory_usage().m_szHops != 2 * 6 * sizeof(intptr_t)) throw std::runtime_error("TEST adaptive hops #2 FAILED");
+
+        // A hot instance keeps its chains while read, and gets shallow ones at the next write
+        ovHot.set_adaptive_hops(true, 1, 7);
+        ovHot = 33;
+        size_t szHops(ovHot.memory_usage().m_szHops);
+        uint32_t ui32Sum(0);
+        for (int i(0); i < 20000; ++i)
+            ui32Sum += ovHot;
+        if (ui32Sum != 20000u * 33 || ovHot.memory_usage().m_szHops != szHops) throw std::runtime_error("TEST adaptive hops #3 FAILED");
+        ovHot += 1;
+        if (ovHot.memory_usage().m_szHops > 2 * 2 * sizeof(intptr_t)) throw std::runtime_error("TEST adaptive hops #4 FAILED");
+        if (ovHot != 34) throw std::runtime_error("TEST adaptive hops #5 FAILED");
+    }
+
+#if defined(MESCAMIT_PROFILE)
+    {
+        // The table filled directly
+        CvarObfuscated<void>::profile_reset();
+        std::source_location loc(std::source_location::current());
+        Sprofiler::Sslot *ptrSlotA(Sprofiler::site(loc, "load", "TestType"));
+        for (int i(0); i < 3; ++i)
+            const Sprofiler::Sscope scope(Sprofiler::site(loc, "load", "TestType"));
+        if (ptrSlotA == nullptr || ptrSlotA->m_ui64Calls != 3) throw std::runtime_error("TEST profiler #1 FAILED");
+        if (Sprofiler::site(loc, "store", "TestType") == ptrSlotA) throw std::runtime_error("TEST profiler #2 FAILED");
+
+        std::ostringstream oss;
+        CvarObfuscated<void>::profile_report(oss);
+        if (oss.str().find("load, TestType, ") == std::string::npos || oss.str().find(":" + std::to_string(loc.line())) == std::string::npos) throw std::runtime_error("TEST profiler #3 FAILED");
+        CvarObfuscated<void>::profile_reset();
+        if (ptrSlotA->m_ui64Calls != 0) throw std::runtime_error("TEST profiler #4 FAILED");
+    }
+    {
+        // The operators counted per return address, the named methods per source location
+        CvarObfuscated<void>::profile_reset();
+        CvarObfuscated<int> ovProf;
+        for (int i(0); i < 3; ++i)
+            ovProf += 2;
+        uint32_t ui32Line(std::source_location::current().line() + 1);
+        int iVal(ovProf.load());
+
+        uint64_t ui64Operator(0), ui64Load(0);
+        for (const Sprofiler::Sslot &slot : Sprofiler::s_arrSlots) {
+            if (!slot.m_bReady || slot.m_szType != std::string_view(typeid(int).name()))
+                continue;
+            if (slot.m_szOperator == std::string_view("operator +=") && slot.m_ptrAddr != nullptr)
+                ui64Operator += slot.m_ui64Calls;
+            if (slot.m_szOperator == std::string_view("load") && slot.m_ui32Line == ui32Line)
+                ui64Load += slot.m_ui64Calls;
+        }
+        if (iVal != 6 || ui64Operator != 3) throw std::runtime_error("TEST profiler #5 FAILED");
+        if (ui64Load != 1) throw std::runtime_error("TEST profiler #6 FAILED");
+        CvarObfuscated<void>::profile_reset();
+    }
+#else
+    {
+        // Nothing is compiled in, the report says so
+        std::ostringstream oss;
+        CvarObfuscated<void>::profile_reset();
+        CvarObfuscated<void>::profile_report(oss);
+        if (oss.str().find("MESCAMIT_PROFILE") == std::string::npos) throw std::runtime_error("TEST profiler #1 FAILED");
+    }
+#endif
 }
 
 